@@ -200,7 +200,7 @@ namespace gt::dx11
     {
         using enum LS::Input::KEYBOARD;
         LS::Vec3F movement;
-        auto dt = g_clock.GetDeltaTimeUs();
+        auto dt = g_clock.GetDeltaTimeNs();
         float movespeed = 300.0f / dt;
 
         if (LS::Win32::IsKeyPressed(W))
@@ -351,11 +351,13 @@ void gt::dx11::DX11CubeApp::Run()
         }
 
         g_clock.Tick();
-        uint64_t dt = g_clock.GetDeltaTimeUs();
+        uint64_t dt = g_clock.GetDeltaTimeNs();
         m_Window->PollEvent();
         Update(dt);
         Draw();
     }
+
+    Shutdown();
 }
 
 static LS::Vec2<uint32_t> g_lastPoint;
@@ -390,7 +392,7 @@ void gt::dx11::DX11CubeApp::OnMouseMove(uint32_t x, uint32_t y)
     {
         int lx = x - g_lastPoint.x;
         int ly = y - g_lastPoint.y;
-        auto dt = g_clock.GetDeltaTimeUs();
+        auto dt = g_clock.GetDeltaTimeNs();
         float mx = lx * 0.03f;
         float my = ly * 0.02f;
         // Normalize between screen size //
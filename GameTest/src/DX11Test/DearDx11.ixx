@@ -270,6 +270,7 @@ void gt::dx11::ImGuiDx11::Run()
         }
     }
 
+    Shutdown();
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
@@ -777,6 +777,7 @@ void gt::dx12::DX12CubeApp::Run()
         Render(0.20f, 0.38f, 0.65f, 1.0f);
     }*/
     DemoRun();
+    Shutdown();
 }
 
 void gt::dx12::DX12CubeApp::UpdateBufferResource(WRL::ComPtr<ID3D12GraphicsCommandList>& commandList, ID3D12Resource** pDestinationResource, ID3D12Resource** pIntermediateResource, size_t numElements, size_t elementSize, const void* bufferData, D3D12_RESOURCE_FLAGS flags)
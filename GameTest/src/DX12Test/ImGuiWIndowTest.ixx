@@ -181,6 +181,7 @@ void gt::dx12::ImGuiSample::ImGuiSample::Run()
         WaitForLastSubmittedFrame();
     }
 
+    Shutdown();
     OnDestroy();
     ImGui_ImplDX12_Shutdown();
     ImGui_ImplWin32_Shutdown();
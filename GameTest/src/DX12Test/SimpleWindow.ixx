@@ -105,6 +105,7 @@ void gt::dx12::SimpleWindow::Run()
         OnUpdate();
     }
 
+    Shutdown();
     OnDestroy();
 }
 
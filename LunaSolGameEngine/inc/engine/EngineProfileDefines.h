@@ -0,0 +1,21 @@
+#pragma once
+import Engine.Profiler;
+
+#define LS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LS_PROFILE_CONCAT(a, b) LS_PROFILE_CONCAT_IMPL(a, b)
+
+#if LS_ENABLE_PROFILE
+// Times the rest of the enclosing scope, name must be a string literal
+#define LS_PROFILE_ZONE(name) LS::Profile::ScopedZone LS_PROFILE_CONCAT(lsProfileZone_, __LINE__){ name }
+#define LS_PROFILE_FUNCTION() LS_PROFILE_ZONE(__func__)
+#define LS_PROFILE_COUNTER(name, value) LS::Profile::RecordCounter(name, static_cast<double>(value))
+// Marks the end of the current frame, call once per frame from the frame loop
+#define LS_PROFILE_FRAME() LS::Profile::MarkFrame()
+#define LS_PROFILE_THREAD(name) LS::Profile::SetThreadName(name)
+#else
+#define LS_PROFILE_ZONE(name)
+#define LS_PROFILE_FUNCTION()
+#define LS_PROFILE_COUNTER(name, value)
+#define LS_PROFILE_FRAME()
+#define LS_PROFILE_THREAD(name)
+#endif
@@ -93,6 +93,7 @@ export namespace LS
                 && (this->MIN_FILTER == rhs.MIN_FILTER)
                 && (this->MAG_FILTER == rhs.MAG_FILTER)
                 && (this->MIP_FILTER == rhs.MIP_FILTER)
+                && (this->FILTER_TYPE == rhs.FILTER_TYPE)
                 && (this->ADDRESS_U == rhs.ADDRESS_U)
                 && (this->ADDRESS_V == rhs.ADDRESS_V)
                 && (this->ADDRESS_W == rhs.ADDRESS_W)
@@ -0,0 +1,505 @@
+module;
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <vector>
+
+export module LSE.Serialize.MeshCache;
+import LSDataLib;
+import Engine.Defines;
+import Engine.EngineCodes;
+import Helper.IO;
+import Util.StdUtils;
+import LSE.Serialize.WavefrontObj;
+
+namespace fs = std::filesystem;
+
+export namespace LS::Serialize
+{
+    /**
+     * @brief Location of an array inside of a mesh cache file
+     */
+    struct MeshCacheSection
+    {
+        uint64_t Offset = 0u;// @brief Byte offset from the start of the file
+        uint64_t Count = 0u;// @brief Number of elements (not bytes) in the section
+    };
+
+    /**
+     * @brief The header at the start of every mesh cache file.
+     *
+     * The sections follow the header, each aligned to MeshCache::SECTION_ALIGNMENT. Index sections
+     * are all stored with the same IndexStride (2 or 4 bytes), missing texture coordinate or normal
+     * indices are stored as the max value of that stride.
+     */
+    struct MeshCacheHeader
+    {
+        uint32_t Magic = 0u;
+        uint32_t Version = 0u;
+        uint32_t IndexStride = 0u;
+        uint32_t Reserved = 0u;
+        uint64_t SourceHash = 0u;// @brief Content hash of the source file the cache was built from
+        uint64_t SourceSize = 0u;
+        int64_t SourceWriteTime = 0;
+        MeshCacheSection Positions;
+        MeshCacheSection Normals;
+        MeshCacheSection TexCoords;
+        MeshCacheSection Indices;
+        MeshCacheSection TexCoordIndices;
+        MeshCacheSection NormalIndices;
+    };
+
+    /**
+     * @brief Identifies the source file a cache was built from
+     */
+    struct MeshSourceInfo
+    {
+        uint64_t Hash = 0u;
+        uint64_t Size = 0u;
+        int64_t WriteTime = 0;
+    };
+
+    /**
+     * @brief A binary mesh container that is memory mapped on load. All getters are views into the mapped file
+     * and are only valid while the cache is alive.
+     */
+    class MeshCache
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x434D'534C;// "LSMC"
+        static constexpr uint32_t VERSION = 1u;
+        static constexpr uint64_t SECTION_ALIGNMENT = 64u;
+
+        MeshCache() = default;
+        ~MeshCache() = default;
+
+        MeshCache(const MeshCache&) = delete;
+        MeshCache& operator=(const MeshCache&) = delete;
+        MeshCache(MeshCache&&) = default;
+        MeshCache& operator=(MeshCache&&) = default;
+
+        /**
+         * @brief Writes the mesh data of obj to the cache file, indices are narrowed to 16-bit when possible
+         * @param cacheFile The file to write to. It is written to a temporary file next to it first and then renamed over it,
+         * so an existing cache is never left half written
+         * @param obj The loaded obj, if it was not loaded with WavefrontObj::LoadStreamed the faces are triangulated
+         * @param source Describes the source file, see @link LS::Serialize::DescribeMeshSource
+         */
+        [[nodiscard]] static auto Write(const fs::path& cacheFile, const WavefrontObj& obj, const MeshSourceInfo& source) noexcept -> LS::System::ErrorCode;
+
+        /**
+         * @brief Maps the cache file and validates its header and sections, no per element work is done
+         * @param cacheFile The file to map
+         */
+        [[nodiscard]] auto Load(const fs::path& cacheFile) noexcept -> LS::System::ErrorCode;
+
+        /**
+         * @brief Checks if the cache was built from the current contents of the source file.
+         * A different size means it is stale. Otherwise the write time is compared and the contents are only
+         * hashed when it differs. If only the write time changed the cache's header is updated to it, so the
+         * next check is fast again.
+         * @param sourceFile The file the cache was built from
+         * @param described If not null, receives the source description when the contents were hashed, so a
+         * rebuild can pass it to Write instead of hashing the file again
+         */
+        [[nodiscard]] auto IsCurrent(const fs::path& sourceFile, Nullable<MeshSourceInfo>* described = nullptr) noexcept -> bool;
+
+        auto GetHeader() const noexcept -> const MeshCacheHeader&
+        {
+            return m_header;
+        }
+
+        auto GetPositions() const noexcept -> std::span<const Vec3F>
+        {
+            return SectionAs<Vec3F>(m_header.Positions);
+        }
+
+        auto GetNormals() const noexcept -> std::span<const Vec3F>
+        {
+            return SectionAs<Vec3F>(m_header.Normals);
+        }
+
+        auto GetTexCoords() const noexcept -> std::span<const Vec2F>
+        {
+            return SectionAs<Vec2F>(m_header.TexCoords);
+        }
+
+        /**
+         * @brief The size in bytes of each index (2 or 4), use the matching type with the index getters
+         */
+        auto GetIndexStride() const noexcept -> uint32_t
+        {
+            return m_header.IndexStride;
+        }
+
+        /**
+         * @brief The triangle list indices, empty if T does not match GetIndexStride()
+         */
+        template <class T> requires std::same_as<T, uint16_t> || std::same_as<T, uint32_t>
+        auto GetIndices() const noexcept -> std::span<const T>
+        {
+            return IndexSectionAs<T>(m_header.Indices);
+        }
+
+        template <class T> requires std::same_as<T, uint16_t> || std::same_as<T, uint32_t>
+        auto GetTexCoordIndices() const noexcept -> std::span<const T>
+        {
+            return IndexSectionAs<T>(m_header.TexCoordIndices);
+        }
+
+        template <class T> requires std::same_as<T, uint16_t> || std::same_as<T, uint32_t>
+        auto GetNormalIndices() const noexcept -> std::span<const T>
+        {
+            return IndexSectionAs<T>(m_header.NormalIndices);
+        }
+
+    private:
+        LS::IO::MappedFile m_file;
+        MeshCacheHeader m_header;
+        fs::path m_path;
+
+        [[nodiscard]] auto RefreshWriteTime(int64_t writeTime) noexcept -> bool;
+
+        template <class T>
+        auto SectionAs(const MeshCacheSection& section) const noexcept -> std::span<const T>
+        {
+            if (section.Count == 0u)
+                return {};
+            return { reinterpret_cast<const T*>(m_file.Data().data() + section.Offset), static_cast<size_t>(section.Count) };
+        }
+
+        template <class T>
+        auto IndexSectionAs(const MeshCacheSection& section) const noexcept -> std::span<const T>
+        {
+            if (sizeof(T) != m_header.IndexStride)
+                return {};
+            return SectionAs<T>(section);
+        }
+    };
+
+    /**
+     * @brief Hashes the source file's contents and records its size and write time
+     * @param sourceFile The file to describe
+     * @return The description or std::nullopt if the file could not be read
+     */
+    [[nodiscard]] auto DescribeMeshSource(const fs::path& sourceFile) noexcept -> Nullable<MeshSourceInfo>;
+
+    /**
+     * @brief Loads the cache for the obj file. When the cache is missing or out of date the obj is parsed with
+     * WavefrontObj::LoadStreamed and the cache is rebuilt first.
+     * @param objFile The source obj file
+     * @param cacheFile The cache file to load or build
+     * @param out The loaded cache
+     */
+    [[nodiscard]] auto LoadMeshCached(const fs::path& objFile, const fs::path& cacheFile, MeshCache& out) noexcept -> LS::System::ErrorCode;
+}
+
+module : private;
+
+namespace LS::Serialize
+{
+    static_assert(sizeof(Vec3F) == 3 * sizeof(float), "Vec3F must be tightly packed to be mapped from a cache");
+    static_assert(sizeof(Vec2F) == 2 * sizeof(float), "Vec2F must be tightly packed to be mapped from a cache");
+
+    constexpr auto AlignUp(uint64_t value, uint64_t alignment) noexcept -> uint64_t
+    {
+        return (value + alignment - 1u) & ~(alignment - 1u);
+    }
+
+    auto GetWriteTime(const fs::path& file) noexcept -> int64_t
+    {
+        std::error_code ec;
+        const auto time = fs::last_write_time(file, ec);
+        return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    /**
+     * @brief Fan triangulates the faces of an obj that was loaded with the line based loader
+     */
+    void TriangulateFaces(std::span<const WavefrontObj::Face> faces, std::vector<uint32_t>& indices,
+        std::vector<uint32_t>& uvIndices, std::vector<uint32_t>& normalIndices)
+    {
+        for (const auto& face : faces)
+        {
+            for (auto i = 2u; i < face.Indices.size(); ++i)
+            {
+                for (const auto corner : { 0u, i - 1u, i })
+                {
+                    indices.push_back(static_cast<uint32_t>(face.Indices[corner]));
+                    uvIndices.push_back(corner < face.Texcoords.size() ? static_cast<uint32_t>(face.Texcoords[corner]) : WavefrontObj::InvalidIndex);
+                    normalIndices.push_back(corner < face.Normals.size() ? static_cast<uint32_t>(face.Normals[corner]) : WavefrontObj::InvalidIndex);
+                }
+            }
+        }
+    }
+
+    void WritePadding(std::ofstream& stream, uint64_t offset)
+    {
+        static constexpr std::array<char, MeshCache::SECTION_ALIGNMENT> zeros{};
+        const auto pos = static_cast<uint64_t>(stream.tellp());
+        stream.write(zeros.data(), static_cast<std::streamsize>(offset - pos));
+    }
+
+    template <class T>
+    void WriteSection(std::ofstream& stream, const MeshCacheSection& section, std::span<const T> data)
+    {
+        if (data.empty())
+            return;
+        WritePadding(stream, section.Offset);
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size_bytes()));
+    }
+
+    void WriteIndexSection(std::ofstream& stream, const MeshCacheSection& section, std::span<const uint32_t> indices, uint32_t stride)
+    {
+        if (stride == sizeof(uint32_t))
+        {
+            WriteSection(stream, section, indices);
+            return;
+        }
+
+        std::vector<uint16_t> narrow(indices.size());
+        std::ranges::transform(indices, narrow.begin(), [](uint32_t index)
+            {
+                return index == WavefrontObj::InvalidIndex ? std::numeric_limits<uint16_t>::max() : static_cast<uint16_t>(index);
+            });
+        WriteSection(stream, section, std::span<const uint16_t>(narrow));
+    }
+
+    auto MeshCache::Write(const fs::path& cacheFile, const WavefrontObj& obj, const MeshSourceInfo& source) noexcept -> LS::System::ErrorCode
+    {
+        try
+        {
+            std::span<const uint32_t> indices = obj.GetIndices();
+            std::span<const uint32_t> uvIndices = obj.GetTexCoordIndices();
+            std::span<const uint32_t> normalIndices = obj.GetNormalIndices();
+
+            std::vector<uint32_t> triIndices, triUvIndices, triNormalIndices;
+            if (indices.empty() && !obj.GetFaces().empty())
+            {
+                TriangulateFaces(obj.GetFaces(), triIndices, triUvIndices, triNormalIndices);
+                indices = triIndices;
+                uvIndices = obj.GetTexCoords().empty() ? std::span<const uint32_t>{} : triUvIndices;
+                normalIndices = obj.GetNormals().empty() ? std::span<const uint32_t>{} : triNormalIndices;
+            }
+
+            // The max value of a 16-bit index marks a missing index, so it cannot address an element
+            const auto largest = std::max({ obj.GetVertices().size(), obj.GetTexCoords().size(), obj.GetNormals().size() });
+            const uint32_t stride = largest < std::numeric_limits<uint16_t>::max() ? sizeof(uint16_t) : sizeof(uint32_t);
+
+            MeshCacheHeader header{
+                .Magic = MAGIC,
+                .Version = VERSION,
+                .IndexStride = stride,
+                .SourceHash = source.Hash,
+                .SourceSize = source.Size,
+                .SourceWriteTime = source.WriteTime
+            };
+
+            uint64_t offset = AlignUp(sizeof(MeshCacheHeader), SECTION_ALIGNMENT);
+            auto place = [&offset](MeshCacheSection& section, size_t count, size_t elementSize)
+                {
+                    section = { .Offset = offset, .Count = count };
+                    offset = AlignUp(offset + count * elementSize, SECTION_ALIGNMENT);
+                };
+            place(header.Positions, obj.GetVertices().size(), sizeof(Vec3F));
+            place(header.Normals, obj.GetNormals().size(), sizeof(Vec3F));
+            place(header.TexCoords, obj.GetTexCoords().size(), sizeof(Vec2F));
+            place(header.Indices, indices.size(), stride);
+            place(header.TexCoordIndices, uvIndices.size(), stride);
+            place(header.NormalIndices, normalIndices.size(), stride);
+
+            // Readers (or a crash) must never see a partially written cache, so it only replaces the old one once complete
+            auto tempFile = cacheFile;
+            tempFile += ".tmp";
+            {
+                std::ofstream stream(tempFile, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!stream.is_open())
+                {
+                    return LS::System::CreateFailCode(std::format("Unable to open mesh cache for writing: {}", tempFile.string()), LS::ENGINE_CODE::FILE_ERROR);
+                }
+
+                stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                WriteSection(stream, header.Positions, obj.GetVertices());
+                WriteSection(stream, header.Normals, obj.GetNormals());
+                WriteSection(stream, header.TexCoords, obj.GetTexCoords());
+                WriteIndexSection(stream, header.Indices, indices, stride);
+                WriteIndexSection(stream, header.TexCoordIndices, uvIndices, stride);
+                WriteIndexSection(stream, header.NormalIndices, normalIndices, stride);
+                stream.close();
+
+                if (!stream.good())
+                {
+                    std::error_code ec;
+                    fs::remove(tempFile, ec);
+                    return LS::System::CreateFailCode(std::format("Failed writing mesh cache: {}", tempFile.string()), LS::ENGINE_CODE::IO_FAIL);
+                }
+            }
+
+            std::error_code ec;
+            fs::rename(tempFile, cacheFile, ec);
+            if (ec)
+            {
+                fs::remove(tempFile, ec);
+                return LS::System::CreateFailCode(std::format("Unable to replace mesh cache: {}", cacheFile.string()), LS::ENGINE_CODE::FILE_ERROR);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            return LS::System::CreateFailCode(e.what());
+        }
+
+        return LS::System::CreateSuccessCode();
+    }
+
+    auto MeshCache::Load(const fs::path& cacheFile) noexcept -> LS::System::ErrorCode
+    {
+        m_header = {};
+        if (!m_file.Open(cacheFile))
+        {
+            return LS::System::CreateFailCode(std::format("Unable to map mesh cache: {}", cacheFile.string()), LS::ENGINE_CODE::FILE_ERROR);
+        }
+
+        const auto data = m_file.Data();
+        if (data.size() < sizeof(MeshCacheHeader))
+        {
+            m_file.Close();
+            return LS::System::CreateFailCode("Mesh cache is too small to contain a header", LS::ENGINE_CODE::FILE_ERROR);
+        }
+
+        MeshCacheHeader header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.Magic != MAGIC || header.Version != VERSION
+            || (header.IndexStride != sizeof(uint16_t) && header.IndexStride != sizeof(uint32_t)))
+        {
+            m_file.Close();
+            return LS::System::CreateFailCode("Mesh cache has an unknown format or version", LS::ENGINE_CODE::FILE_ERROR);
+        }
+
+        // Empty sections are never read, and trailing ones are placed past the end of the file
+        auto isValid = [&data](const MeshCacheSection& section, uint64_t elementSize)
+            {
+                if (section.Count == 0u)
+                    return true;
+                return section.Offset % SECTION_ALIGNMENT == 0u && section.Offset <= data.size()
+                    && section.Count <= (data.size() - section.Offset) / elementSize;
+            };
+
+        if (!isValid(header.Positions, sizeof(Vec3F)) || !isValid(header.Normals, sizeof(Vec3F))
+            || !isValid(header.TexCoords, sizeof(Vec2F)) || !isValid(header.Indices, header.IndexStride)
+            || !isValid(header.TexCoordIndices, header.IndexStride) || !isValid(header.NormalIndices, header.IndexStride))
+        {
+            m_file.Close();
+            return LS::System::CreateFailCode("Mesh cache sections are out of bounds of the file", LS::ENGINE_CODE::FILE_ERROR);
+        }
+
+        m_header = header;
+        m_path = cacheFile;
+        return LS::System::CreateSuccessCode();
+    }
+
+    auto MeshCache::IsCurrent(const fs::path& sourceFile, Nullable<MeshSourceInfo>* described) noexcept -> bool
+    {
+        if (m_header.Magic != MAGIC)
+            return false;
+
+        std::error_code ec;
+        const auto size = fs::file_size(sourceFile, ec);
+        if (ec)
+            return false;
+
+        if (size != m_header.SourceSize)
+            return false;
+        if (GetWriteTime(sourceFile) == m_header.SourceWriteTime)
+            return true;
+
+        const auto source = DescribeMeshSource(sourceFile);
+        if (described)
+            *described = source;
+        if (!source || source->Size != m_header.SourceSize || source->Hash != m_header.SourceHash)
+            return false;
+
+        // Only the write time changed (e.g. a checkout or copy), record it so the next check skips hashing
+        return RefreshWriteTime(source->WriteTime);
+    }
+
+    auto MeshCache::RefreshWriteTime(int64_t writeTime) noexcept -> bool
+    {
+        try
+        {
+            // Copy the path as Load() assigns it, and release the mapping as it can keep writers out of the file
+            const auto path = m_path;
+            m_file.Close();
+            {
+                std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+                if (stream.is_open())
+                {
+                    stream.seekp(offsetof(MeshCacheHeader, SourceWriteTime));
+                    stream.write(reinterpret_cast<const char*>(&writeTime), sizeof(writeTime));
+                }
+            }
+
+            // A failed write only costs another hash next time, the cache itself is still current
+            return static_cast<bool>(Load(path));
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    auto DescribeMeshSource(const fs::path& sourceFile) noexcept -> Nullable<MeshSourceInfo>
+    {
+        auto mapped = LS::IO::MapFile(sourceFile);
+        if (!mapped)
+            return std::nullopt;
+
+        return MeshSourceInfo{
+            .Hash = LS::Utils::HashBytes(mapped->Data()),
+            .Size = mapped->Size(),
+            .WriteTime = GetWriteTime(sourceFile)
+        };
+    }
+
+    auto LoadMeshCached(const fs::path& objFile, const fs::path& cacheFile, MeshCache& out) noexcept -> LS::System::ErrorCode
+    {
+        std::error_code ec;
+        Nullable<MeshSourceInfo> source;
+        if (fs::exists(cacheFile, ec) && out.Load(cacheFile) && out.IsCurrent(objFile, &source))
+        {
+            return LS::System::CreateSuccessCode();
+        }
+
+        // A stale cache whose source was already hashed by IsCurrent reuses that description
+        if (!source)
+            source = DescribeMeshSource(objFile);
+        if (!source)
+        {
+            return LS::System::CreateFailCode(std::format("Unable to read mesh source: {}", objFile.string()), LS::ENGINE_CODE::FILE_ERROR);
+        }
+
+        // Release the old mapping before the file is replaced
+        out = MeshCache{};
+        {
+            WavefrontObj obj;
+            if (auto result = obj.LoadStreamed(objFile); !result)
+            {
+                return result;
+            }
+
+            if (auto result = MeshCache::Write(cacheFile, obj, *source); !result)
+            {
+                return result;
+            }
+        }
+
+        return out.Load(cacheFile);
+    }
+}
\ No newline at end of file
@@ -12,6 +12,11 @@ module;
 #include <iostream>
 #include <algorithm>
 #include <functional>
+#include <array>
+#include <charconv>
+#include <limits>
+#include <thread>
+#include <vector>
 #include "assimp/Importer.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
@@ -19,6 +24,8 @@ export module LSE.Serialize.WavefrontObj;
 import LSDataLib;
 import Engine.Defines;
 import Engine.EngineCodes;
+import Helper.IO;
+import Engine.Jobs;
 
 namespace LS::Serialize
 {
@@ -89,31 +96,68 @@ export namespace LS::Serialize
         [[nodiscard]] auto ParseFace(std::span<std::string> line) noexcept -> LS::System::ErrorCode;
         [[nodiscard]] auto LoadAssimp(const std::filesystem::path file) noexcept -> LS::System::ErrorCode;
 
-        auto GetFaces() const noexcept -> const std::vector<Face>
+        /**
+         * @brief Maps the file into memory and parses it on multiple threads directly into the vertex and index arrays.
+         * Faces are triangulated as a fan and are returned by GetIndices(), GetTexCoordIndices() and GetNormalIndices()
+         * instead of GetFaces(). Lines are not stored, so GetLines() is empty after this call.
+         * @param file The obj file to load
+         * @param threadCount The number of threads to parse with, 0 uses the hardware's concurrency
+         */
+        [[nodiscard]] auto LoadStreamed(const std::filesystem::path file, uint32_t threadCount = 0u) noexcept -> LS::System::ErrorCode;
+
+        auto GetFaces() const noexcept -> std::span<const Face>
         {
             return m_faces;
         }
         
-        auto GetVertices() const noexcept -> const std::vector<Vec3F>
+        auto GetVertices() const noexcept -> std::span<const Vec3F>
         {
             return m_vertices;
         }
         
-        auto GetNormals() const noexcept -> const std::vector<Vec3F>
+        auto GetNormals() const noexcept -> std::span<const Vec3F>
         {
             return m_normals;
         }
         
-        auto GetTexCoords() const noexcept -> const std::vector<Vec2F>
+        auto GetTexCoords() const noexcept -> std::span<const Vec2F>
         {
             return m_uvs;
         }
 
-        auto GetLines() const noexcept -> const std::vector<std::string>
+        /**
+         * @brief The triangle list indices into GetVertices() (only filled by LoadStreamed)
+         */
+        auto GetIndices() const noexcept -> std::span<const uint32_t>
+        {
+            return m_indices;
+        }
+
+        /**
+         * @brief Indices into GetTexCoords() per triangle corner, empty if the file has no texture coordinates.
+         * Corners without a texture coordinate are set to InvalidIndex.
+         */
+        auto GetTexCoordIndices() const noexcept -> std::span<const uint32_t>
+        {
+            return m_uvIndices;
+        }
+
+        /**
+         * @brief Indices into GetNormals() per triangle corner, empty if the file has no normals.
+         * Corners without a normal are set to InvalidIndex.
+         */
+        auto GetNormalIndices() const noexcept -> std::span<const uint32_t>
+        {
+            return m_normalIndices;
+        }
+
+        auto GetLines() const noexcept -> std::span<const std::string>
         {
             return m_lines;
         }
 
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
         void SetClockwise(bool isCounterClockwise) noexcept
         {
             IsCounterClockwise = isCounterClockwise;
@@ -127,6 +171,8 @@ export namespace LS::Serialize
         std::vector<Vec2F> m_uvs;
         std::vector<Face> m_faces;
         std::vector<uint32_t> m_indices;
+        std::vector<uint32_t> m_uvIndices;
+        std::vector<uint32_t> m_normalIndices;
         bool IsCounterClockwise = false;
     };
 }
@@ -306,6 +352,15 @@ namespace LS::Serialize
     [[nodiscard]]
     auto WavefrontObj::LoadObject() noexcept -> LS::System::ErrorCode
     {
+        // Rebuild from the lines, dropping anything left by a previous load (including LoadStreamed's indices)
+        m_vertices.clear();
+        m_normals.clear();
+        m_uvs.clear();
+        m_faces.clear();
+        m_indices.clear();
+        m_uvIndices.clear();
+        m_normalIndices.clear();
+
         std::string delim = " ";
         for (auto& l : m_lines)
         {
@@ -424,70 +479,511 @@ namespace LS::Serialize
             return LS::System::CreateFailCode(importer.GetErrorString());
         }
 
-        auto printFaceInfo = [&](const aiFace* face) -> void {
+        // Assimp only fills the faces, so indices from an earlier LoadStreamed would no longer match
+        m_indices.clear();
+        m_uvIndices.clear();
+        m_normalIndices.clear();
+
+        auto processFace = [&](const aiFace* face) -> void {
             if (!face)
                 return;
 
-            std::cout << std::format("        Face has: {} points\n", face->mNumIndices);
-            std::cout << std::format("            Indices:( ", face->mNumIndices);
-
             Face myFace;
+            myFace.Indices.reserve(face->mNumIndices);
             for (auto i = 0u; i < face->mNumIndices; i++)
             {
-                std::cout << std::format("{}, ", face->mIndices[i]);
                 myFace.Indices.push_back(face->mIndices[i]);
             }
-            std::cout << ")\n";
-            m_faces.emplace_back(myFace);
+            m_faces.emplace_back(std::move(myFace));
             };
 
-        auto printMeshInfo = [&](const aiMesh* mesh) -> void
+        auto processMesh = [&](const aiMesh* mesh) -> void
             {
                 if (!mesh)
                     return;
 
                 if (mesh->HasFaces())
                 {
-                    std::cout << std::format("      This mesh has {} faces\n", mesh->mNumFaces);
+                    m_faces.reserve(m_faces.size() + mesh->mNumFaces);
                     for (auto i = 0u; i < mesh->mNumFaces; ++i)
                     {
-                        printFaceInfo(&mesh->mFaces[i]);
+                        processFace(&mesh->mFaces[i]);
                     }
                 }
                 if (mesh->HasPositions())
                 {
+                    m_vertices.reserve(m_vertices.size() + mesh->mNumVertices);
                     for (auto i = 0u; i < mesh->mNumVertices; ++i)
                     {
                         const auto vert = mesh->mVertices[i];
-                        std::cout << std::format("        Vertex {}: ({}, {}, {})\n", i, vert.x, vert.y, vert.z);
-                        Vec3F vertex(vert.x, vert.y, vert.z);
-                        m_vertices.emplace_back(vertex);
+                        m_vertices.emplace_back(Vec3F{ .x = vert.x, .y = vert.y, .z = vert.z });
                     }
                 }
             };
 
-        std::function<void(const aiNode*)> printChildren = [&](const aiNode* child) -> void
+        std::function<void(const aiNode*)> processNode = [&](const aiNode* child) -> void
             {
-                std::cout << std::format("Root node found: {}\n", child->mName.C_Str());
                 for (auto i = 0u; i < child->mNumChildren; ++i)
                 {
-                    std::cout << std::format("{: >4}\n", child->mChildren[i]->mName.C_Str());
-                    std::cout << std::format("    Children count: {}\n", child->mNumChildren);
-                    printChildren(child->mChildren[i]);
+                    processNode(child->mChildren[i]);
+                }
+
+                for (auto j = 0u; j < child->mNumMeshes; ++j)
+                {
+                    auto index = child->mMeshes[j];
+                    processMesh(scene->mMeshes[index]);
+                }
+            };
+
+        processNode(scene->mRootNode);
+        return LS::System::CreateSuccessCode();
+    }
+
+    // Streamed Loading //
+    // Chunks smaller than this are not worth handing to another thread
+    constexpr size_t MIN_CHUNK_SIZE = 1u << 20;
+
+    enum class ObjLineType
+    {
+        Other,
+        Vertex,
+        Texture,
+        Normal,
+        Face,
+    };
+
+    /**
+     * @brief Number of elements found in a chunk, also used as the starting offsets of a chunk into the output arrays
+     */
+    struct ObjChunkCounts
+    {
+        size_t Vertices = 0u;
+        size_t Uvs = 0u;
+        size_t Normals = 0u;
+        size_t Triangles = 0u;
+    };
+
+    struct ObjStreamTargets
+    {
+        std::span<Vec3F> Vertices;
+        std::span<Vec2F> Uvs;
+        std::span<Vec3F> Normals;
+        std::span<uint32_t> Indices;
+        std::span<uint32_t> UvIndices;
+        std::span<uint32_t> NormalIndices;
+        ObjChunkCounts Totals;
+        bool IsCounterClockwise = false;
+    };
+
+    constexpr bool IsSpace(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    constexpr auto SkipSpaces(const char* first, const char* last) noexcept -> const char*
+    {
+        while (first != last && IsSpace(*first))
+            ++first;
+        return first;
+    }
+
+    constexpr auto SkipToken(const char* first, const char* last) noexcept -> const char*
+    {
+        while (first != last && !IsSpace(*first))
+            ++first;
+        return first;
+    }
+
+    /**
+     * @brief Identifies the line's type and moves first past its token
+     */
+    constexpr auto ClassifyLine(const char*& first, const char* last) noexcept -> ObjLineType
+    {
+        first = SkipSpaces(first, last);
+        const auto token = std::string_view(first, SkipToken(first, last));
+        first += token.size();
+
+        if (token == "v")
+            return ObjLineType::Vertex;
+        if (token == "vt")
+            return ObjLineType::Texture;
+        if (token == "vn")
+            return ObjLineType::Normal;
+        if (token == "f")
+            return ObjLineType::Face;
+        return ObjLineType::Other;
+    }
+
+    /**
+     * @brief Splits the text into chunks for each thread, each chunk ends on a new line
+     */
+    auto SplitChunks(std::string_view text, size_t count) -> std::vector<std::string_view>
+    {
+        std::vector<std::string_view> chunks;
+        const auto chunkSize = text.size() / count + 1;
+        size_t offset = 0u;
+        while (offset < text.size())
+        {
+            auto end = std::min(offset + chunkSize, text.size());
+            end = text.find('\n', end - 1);
+            end = (end == std::string_view::npos) ? text.size() : end + 1;
+            chunks.emplace_back(text.substr(offset, end - offset));
+            offset = end;
+        }
+        return chunks;
+    }
+
+    /**
+     * @brief Invokes func(type, first, last) for each line in the chunk, where first is past the line's token
+     */
+    template <class Func>
+    auto ForEachLine(std::string_view chunk, Func&& func) -> LS::System::ErrorCode
+    {
+        const char* pos = chunk.data();
+        const char* const end = chunk.data() + chunk.size();
+        while (pos != end)
+        {
+            const char* lineEnd = std::find(pos, end, '\n');
+            const char* first = pos;
+            const auto type = ClassifyLine(first, lineEnd);
+            if (type != ObjLineType::Other)
+            {
+                if (auto result = func(type, first, lineEnd); !result)
+                {
+                    return result;
                 }
+            }
+            pos = (lineEnd == end) ? end : lineEnd + 1;
+        }
+
+        return LS::System::CreateSuccessCode();
+    }
+
+    auto CountChunk(std::string_view chunk, ObjChunkCounts& counts) -> LS::System::ErrorCode
+    {
+        return ForEachLine(chunk, [&counts](ObjLineType type, const char* first, const char* last)
+            {
+                switch (type)
+                {
+                case ObjLineType::Vertex:
+                    ++counts.Vertices;
+                    break;
+                case ObjLineType::Texture:
+                    ++counts.Uvs;
+                    break;
+                case ObjLineType::Normal:
+                    ++counts.Normals;
+                    break;
+                case ObjLineType::Face:
+                {
+                    size_t corners = 0u;
+                    for (first = SkipSpaces(first, last); first != last; first = SkipSpaces(first, last))
+                    {
+                        first = SkipToken(first, last);
+                        ++corners;
+                    }
+                    counts.Triangles += corners > 2 ? corners - 2 : 0u;
+                    break;
+                }
+                default:
+                    break;
+                }
+                return LS::System::CreateSuccessCode();
+            });
+    }
+
+    /**
+     * @brief Parses up to N floats, the record is rejected if it has fewer than Required of them
+     */
+    template <size_t Required, size_t N>
+    auto ParseFloats(const char* first, const char* last, std::array<float, N>& out) noexcept -> bool
+    {
+        static_assert(Required > 0u && Required <= N);
+        for (auto i = 0u; i < N; ++i)
+        {
+            first = SkipSpaces(first, last);
+            if (first != last && *first == '+')
+                ++first;
+
+            const auto [ptr, ec] = std::from_chars(first, last, out[i]);
+            if (ec != std::errc{})
+            {
+                // Only trailing components past Required (such as a texture's v) are optional
+                return i >= Required && (first == last);
+            }
+            first = ptr;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Converts an obj index (1 based, or negative and relative to the current count) to a 0 based index
+     */
+    constexpr auto ResolveIndex(int64_t index, size_t current, size_t total) noexcept -> uint32_t
+    {
+        const auto resolved = index > 0 ? index - 1 : static_cast<int64_t>(current) + index;
+        if (index == 0 || resolved < 0 || static_cast<size_t>(resolved) >= total)
+            return WavefrontObj::InvalidIndex;
+        return static_cast<uint32_t>(resolved);
+    }
+
+    struct ObjCorner
+    {
+        uint32_t Vertex = WavefrontObj::InvalidIndex;
+        uint32_t Uv = WavefrontObj::InvalidIndex;
+        uint32_t Normal = WavefrontObj::InvalidIndex;
+    };
+
+    auto ParseIndex(const char*& first, const char* last, int64_t& out) noexcept -> bool
+    {
+        const auto [ptr, ec] = std::from_chars(first, last, out);
+        first = ptr;
+        return ec == std::errc{};
+    }
 
-                if (child->mNumMeshes > 0)
+    /**
+     * @brief Parses a single face corner of the forms v, v/vt, v//vn or v/vt/vn
+     */
+    auto ParseCorner(const char* first, const char* last, const ObjChunkCounts& current, const ObjChunkCounts& totals, ObjCorner& out) noexcept -> bool
+    {
+        int64_t index = 0;
+        if (!ParseIndex(first, last, index))
+            return false;
+
+        out.Vertex = ResolveIndex(index, current.Vertices, totals.Vertices);
+        if (out.Vertex == WavefrontObj::InvalidIndex)
+            return false;
+
+        if (first == last || *first != '/')
+            return first == last;
+        ++first;
+
+        if (first != last && *first != '/')
+        {
+            if (!ParseIndex(first, last, index))
+                return false;
+            out.Uv = ResolveIndex(index, current.Uvs, totals.Uvs);
+        }
+
+        if (first == last || *first != '/')
+            return first == last;
+        ++first;
+
+        if (!ParseIndex(first, last, index))
+            return false;
+        out.Normal = ResolveIndex(index, current.Normals, totals.Normals);
+        return first == last;
+    }
+
+    /**
+     * @brief Parses the chunk into the targets, starting at the offsets given by base
+     */
+    auto ParseChunk(std::string_view chunk, ObjChunkCounts base, const ObjStreamTargets& targets) -> LS::System::ErrorCode
+    {
+        auto writeCorner = [&](size_t index, const ObjCorner& corner)
+            {
+                targets.Indices[index] = corner.Vertex;
+                if (!targets.UvIndices.empty())
+                    targets.UvIndices[index] = corner.Uv;
+                if (!targets.NormalIndices.empty())
+                    targets.NormalIndices[index] = corner.Normal;
+            };
+
+        return ForEachLine(chunk, [&](ObjLineType type, const char* first, const char* last) -> LS::System::ErrorCode
+            {
+                switch (type)
+                {
+                case ObjLineType::Vertex:
+                {
+                    std::array<float, 3> v{};
+                    if (!ParseFloats<3>(first, last, v))
+                        return LS::System::CreateFailCode(std::format("Invalid vertex: {}", std::string_view(first, last)));
+                    targets.Vertices[base.Vertices++] = Vec3F{ .x = v[0], .y = v[1], .z = v[2] };
+                    break;
+                }
+                case ObjLineType::Texture:
+                {
+                    std::array<float, 2> vt{};
+                    if (!ParseFloats<1>(first, last, vt))
+                        return LS::System::CreateFailCode(std::format("Invalid texture coordinate: {}", std::string_view(first, last)));
+                    targets.Uvs[base.Uvs++] = Vec2F{ .x = vt[0], .y = vt[1] };
+                    break;
+                }
+                case ObjLineType::Normal:
                 {
-                    std::cout << std::format("Child has meshes: {}\n", child->mNumMeshes);
-                    for (auto j = 0u; j < child->mNumMeshes; ++j)
+                    std::array<float, 3> vn{};
+                    if (!ParseFloats<3>(first, last, vn))
+                        return LS::System::CreateFailCode(std::format("Invalid normal: {}", std::string_view(first, last)));
+                    targets.Normals[base.Normals++] = Vec3F{ .x = vn[0], .y = vn[1], .z = vn[2] };
+                    break;
+                }
+                case ObjLineType::Face:
+                {
+                    // Triangulate as a fan around the first corner
+                    ObjCorner firstCorner;
+                    ObjCorner prevCorner;
+                    size_t corners = 0u;
+                    for (first = SkipSpaces(first, last); first != last; first = SkipSpaces(first, last))
                     {
-                        auto index = child->mMeshes[j];
-                        printMeshInfo(scene->mMeshes[index]);
+                        const auto tokenEnd = SkipToken(first, last);
+                        ObjCorner corner;
+                        if (!ParseCorner(first, tokenEnd, base, targets.Totals, corner))
+                            return LS::System::CreateFailCode(std::format("Invalid face: {}", std::string_view(first, tokenEnd)));
+                        first = tokenEnd;
+
+                        if (corners >= 2)
+                        {
+                            const auto index = base.Triangles++ * 3;
+                            writeCorner(index, firstCorner);
+                            writeCorner(index + 1, targets.IsCounterClockwise ? corner : prevCorner);
+                            writeCorner(index + 2, targets.IsCounterClockwise ? prevCorner : corner);
+                        }
+                        else if (corners == 0)
+                        {
+                            firstCorner = corner;
+                        }
+                        prevCorner = corner;
+                        ++corners;
                     }
+                    break;
+                }
+                default:
+                    break;
+                }
+                return LS::System::CreateSuccessCode();
+            });
+    }
+
+    /**
+     * @brief Runs func(index) for each chunk and stores its result, the first chunk is run on the calling thread.
+     * Jobs and threads must not throw, so an exception thrown by func is stored as that chunk's failure.
+     */
+    template <class Func>
+    void RunChunks(std::span<LS::System::ErrorCode> results, Func&& func)
+    {
+        if (results.empty())
+            return;
+
+        auto runChunk = [&results, &func](size_t i) noexcept
+            {
+                try
+                {
+                    results[i] = func(i);
+                }
+                catch (const std::exception& e)
+                {
+                    results[i] = LS::System::CreateFailCode(e.what());
+                }
+                catch (...)
+                {
+                    results[i] = LS::System::CreateFailCode("Unknown exception while parsing chunk");
                 }
             };
 
-        printChildren(scene->mRootNode);
+        // Prefer the engine scheduler so parsing shares its workers; stand-alone tools get a thread per chunk
+        if (LS::Jobs::Scheduler)
+        {
+            LS::Jobs::ParallelFor(0u, results.size(), runChunk);
+            return;
+        }
+
+        std::vector<std::jthread> workers;
+        workers.reserve(results.size());
+        for (auto i = 1u; i < results.size(); ++i)
+        {
+            workers.emplace_back([&runChunk, i]() { runChunk(i); });
+        }
+        runChunk(0u);
+    }
+
+    [[nodiscard]]
+    auto WavefrontObj::LoadStreamed(const std::filesystem::path file, uint32_t threadCount) noexcept -> LS::System::ErrorCode
+    {
+        auto mapped = LS::IO::MapFile(file);
+        if (!mapped)
+        {
+            return LS::System::CreateFailCode(std::format("Unable to map file: {}", file.string()), LS::ENGINE_CODE::FILE_ERROR);
+        }
+
+        try
+        {
+            const auto text = mapped->AsString();
+            if (threadCount == 0u)
+            {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+            }
+            const auto chunkCount = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE, 1u, threadCount);
+            const auto chunks = SplitChunks(text, chunkCount);
+
+            std::vector<ObjChunkCounts> counts(chunks.size());
+            std::vector<LS::System::ErrorCode> results(chunks.size(), LS::System::CreateSuccessCode());
+            RunChunks(results, [&](size_t i)
+                {
+                    return CountChunk(chunks[i], counts[i]);
+                });
+
+            for (const auto& result : results)
+            {
+                if (!result)
+                    return result;
+            }
+
+            // Exclusive prefix sum turns each chunk's counts into its offsets into the arrays
+            ObjChunkCounts totals;
+            for (auto& c : counts)
+            {
+                const auto local = c;
+                c = totals;
+                totals.Vertices += local.Vertices;
+                totals.Uvs += local.Uvs;
+                totals.Normals += local.Normals;
+                totals.Triangles += local.Triangles;
+            }
+
+            // Parse into locals so a failed load leaves the previously loaded object untouched
+            std::vector<Vec3F> vertices(totals.Vertices);
+            std::vector<Vec2F> uvs(totals.Uvs);
+            std::vector<Vec3F> normals(totals.Normals);
+            std::vector<uint32_t> indices(totals.Triangles * 3);
+            std::vector<uint32_t> uvIndices(totals.Uvs > 0u ? indices.size() : 0u);
+            std::vector<uint32_t> normalIndices(totals.Normals > 0u ? indices.size() : 0u);
+
+            const ObjStreamTargets targets{
+                .Vertices = vertices,
+                .Uvs = uvs,
+                .Normals = normals,
+                .Indices = indices,
+                .UvIndices = uvIndices,
+                .NormalIndices = normalIndices,
+                .Totals = totals,
+                .IsCounterClockwise = IsCounterClockwise
+            };
+
+            RunChunks(results, [&](size_t i)
+                {
+                    return ParseChunk(chunks[i], counts[i], targets);
+                });
+
+            for (const auto& result : results)
+            {
+                if (!result)
+                    return result;
+            }
+
+            m_lines.clear();
+            m_faces.clear();
+            m_vertices.swap(vertices);
+            m_uvs.swap(uvs);
+            m_normals.swap(normals);
+            m_indices.swap(indices);
+            m_uvIndices.swap(uvIndices);
+            m_normalIndices.swap(normalIndices);
+        }
+        catch (const std::exception& e)
+        {
+            return LS::System::CreateFailCode(e.what());
+        }
+
         return LS::System::CreateSuccessCode();
     }
 }
\ No newline at end of file
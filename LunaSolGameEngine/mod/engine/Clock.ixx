@@ -29,7 +29,7 @@ export namespace LS
     {
         using Steady = std::chrono::steady_clock;
         using TimePoint = std::chrono::steady_clock::time_point;
-        // Microseconds represented as UInt64 (1s = 1'000'000'000us, 1ms = 1'000'000us)
+        // Nanoseconds represented as UInt64 (1s = 1'000'000'000ns, 1ms = 1'000'000ns)
         using Duration = std::chrono::nanoseconds;
 
     public:
@@ -59,10 +59,19 @@ export namespace LS
          * @brief Returns the total number of ticks that passed in nanoseconds
          * @return Number of accumulated ticks as nanoseconds
          */
-        constexpr uint64_t GetTotalTimeUs() const
+        constexpr uint64_t GetTotalTimeNs() const
         {
             return (m_currentPoint - m_startPoint).count();
         }
+
+        /**
+         * @brief Returns the total number of ticks that passed in microseconds
+         * @return Number of accumulated ticks as microseconds
+         */
+        constexpr uint64_t GetTotalTimeUs() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(m_currentPoint - m_startPoint).count();
+        }
         
         /**
          * @brief Returns the total number of ticks that passed in milliseconds
@@ -82,13 +91,22 @@ export namespace LS
             return std::chrono::duration_cast<std::chrono::seconds>(m_currentPoint - m_startPoint).count();
         }
 
+        /**
+         * @brief Returns the total time between ticks
+         * @return Number of time between ticks as nanoseconds
+         */
+        constexpr uint64_t GetDeltaTimeNs() const
+        {
+            return m_deltaTime.count();
+        }
+
         /**
          * @brief Returns the total time between ticks
          * @return Number of time between ticks as microseconds
          */
         constexpr uint64_t GetDeltaTimeUs() const
         {
-            return m_deltaTime.count();
+            return std::chrono::duration_cast<std::chrono::microseconds>(m_deltaTime).count();
         }
         
         /**
@@ -106,7 +124,16 @@ export namespace LS
          */
         constexpr uint64_t GetEpochUs() const
         {
-            return (Steady::now() - m_startPoint).count();
+            return std::chrono::duration_cast<std::chrono::microseconds>(Steady::now() - m_startPoint).count();
+        }
+
+        /**
+         * @brief Total time passed since the start of the clock in nanoseconds (ns). Does not require ticking
+         * @return Time passed since the epoch (clock start)
+         */
+        constexpr uint64_t GetEpochNs() const
+        {
+            return std::chrono::duration_cast<Duration>(Steady::now() - m_startPoint).count();
         }
 
         /**
@@ -124,7 +151,7 @@ export namespace LS
         /**
          * @brief Helper function to return time as a specified duration
          * @tparam D the duration to cast to 
-         * @return The internal microseconds timer cast to a specified duration
+         * @return The internal nanoseconds timer cast to a specified duration
          */
         template<class D>
         constexpr uint64_t DeltaTimeIn() const
@@ -9,6 +9,7 @@ import <vector>;
 import <memory>;
 import <ranges>;
 import <filesystem>;
+import <utility>;
 
 import Engine.LSDevice;
 import Engine.LSWindow;
@@ -16,12 +17,14 @@ import Engine.LSCamera;
 import Engine.EngineCodes;
 import Engine.Defines;
 import Engine.Input;
+import Engine.Jobs;
 
 export namespace LS::Global
 {
     //TODO: Not sure I like this, let's consider altering later
     const constinit auto FRAME_COUNT = 3u;
     const constinit auto NUM_CONTEXT = 3u;
+    // Number of worker threads started for the LS::Jobs scheduler
     const constinit auto THREAD_COUNT = 4u;
     uint32_t FrameIndex = 0u;
 }
@@ -64,6 +67,7 @@ namespace LS
     public:
         LSApp()
         {
+            BaseInit();
             m_Window = BuildWindow(600, 600, L"LS Application");
         }
 
@@ -88,8 +92,48 @@ namespace LS
         void RegisterMouseInput(Input::LSOnMouseDown onMouseDown, Input::LSOnMouseUp onMouseUp, Input::LSOnMouseWheelScroll mouseWheel, Input::LSOnMouseMove cursorMove);
         void BaseInit();
 
+        /**
+         * @brief Shuts down the engine services this app started, the LS::Jobs scheduler finishes its queued jobs and stops.
+         * Call at the end of Run: a derived app's members are destroyed before ~LSApp runs, so jobs that use them
+         * must be finished by then. Safe to call more than once, ~LSApp calls it again for apps that do not.
+        */
+        void Shutdown() noexcept;
+
     private:
+        /**
+         * @brief Stops the LS::Jobs scheduler if this app started it, a move hands the ownership over.
+         * Also stops it on destruction, which for a derived app is after its own members are gone, see LSApp::Shutdown.
+        */
+        struct JobsOwner
+        {
+            bool IsOwner = false;
+
+            JobsOwner() = default;
+            JobsOwner(JobsOwner&& other) noexcept : IsOwner(std::exchange(other.IsOwner, false))
+            {
+            }
+
+            JobsOwner& operator=(JobsOwner&& other) noexcept
+            {
+                std::swap(IsOwner, other.IsOwner);
+                return *this;
+            }
+
+            ~JobsOwner()
+            {
+                Release();
+            }
+
+            void Release() noexcept
+            {
+                if (std::exchange(IsOwner, false))
+                    Jobs::ShutdownJobs();
+            }
+        };
+
         void FindAppDir();
+
+        JobsOwner m_jobs;
     };
 
     export template<class T, class... Args>
@@ -132,6 +176,15 @@ namespace LS
     void LSApp::BaseInit()
     {
         FindAppDir();
+        if (!Jobs::Scheduler)
+        {
+            m_jobs.IsOwner = static_cast<bool>(Jobs::InitJobs(Global::THREAD_COUNT));
+        }
+    }
+
+    void LSApp::Shutdown() noexcept
+    {
+        m_jobs.Release();
     }
 
     void LSApp::FindAppDir()
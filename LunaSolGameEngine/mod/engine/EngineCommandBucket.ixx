@@ -0,0 +1,503 @@
+module;
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+export module Engine.CommandBucket;
+import Engine.LSDevice;
+import Engine.Defines;
+
+export namespace LS
+{
+    // Sort key layout, most significant first: layer (8) | pipeline (16) | material (16) | depth (24)
+    constexpr uint32_t SORT_KEY_LAYER_BITS = 8u;
+    constexpr uint32_t SORT_KEY_PIPELINE_BITS = 16u;
+    constexpr uint32_t SORT_KEY_MATERIAL_BITS = 16u;
+    constexpr uint32_t SORT_KEY_DEPTH_BITS = 24u;
+
+    /**
+     * @brief Builds a draw sort key. Draws sort by layer, then pipeline and material to minimize state changes,
+     * then depth. Pipelines and materials above 65535 are clamped to their field's maximum, so they sort together
+     * after every handle that fits instead of wrapping onto a smaller one. Packets keep the full handles for replay.
+     * @param depth A depth from QuantizeDepth
+     */
+    constexpr auto MakeSortKey(uint8_t layer, StateHandle pipeline, uint32_t material, uint32_t depth) noexcept -> uint64_t
+    {
+        constexpr uint64_t pipelineMask = (1ull << SORT_KEY_PIPELINE_BITS) - 1u;
+        constexpr uint64_t materialMask = (1ull << SORT_KEY_MATERIAL_BITS) - 1u;
+        constexpr uint64_t depthMask = (1ull << SORT_KEY_DEPTH_BITS) - 1u;
+
+        return static_cast<uint64_t>(layer) << (SORT_KEY_PIPELINE_BITS + SORT_KEY_MATERIAL_BITS + SORT_KEY_DEPTH_BITS)
+            | std::min<uint64_t>(pipeline, pipelineMask) << (SORT_KEY_MATERIAL_BITS + SORT_KEY_DEPTH_BITS)
+            | std::min<uint64_t>(material, materialMask) << SORT_KEY_DEPTH_BITS
+            | (static_cast<uint64_t>(depth) & depthMask);
+    }
+
+    /**
+     * @brief Maps a normalized depth [0, 1] onto the key's depth bits
+     * @param isBackToFront Reverses the order, for transparent layers that must draw far to near
+     */
+    constexpr auto QuantizeDepth(float depth, bool isBackToFront = false) noexcept -> uint32_t
+    {
+        constexpr uint32_t maxDepth = (1u << SORT_KEY_DEPTH_BITS) - 1u;
+        // A float cannot hold 2^24 - 1 exactly, so scale in double to keep 1.0 inside the field
+        const auto clamped = static_cast<double>(std::clamp(depth, 0.0f, 1.0f));
+        const auto quantized = static_cast<uint32_t>(clamped * maxDepth + 0.5);
+        return isBackToFront ? maxDepth - quantized : quantized;
+    }
+
+    /**
+     * @brief Everything needed to replay one draw. Resources are referenced by handle only.
+     */
+    struct DrawPacket
+    {
+        uint64_t Key = 0u;
+        StateHandle Pipeline = INVALID_STATE_HANDLE;
+        uint32_t Material = 0u;
+        uint32_t Geometry = 0u;
+        uint32_t Count = 0u;//@brief Index count, or vertex count when IsIndexed is false
+        uint32_t InstanceCount = 1u;
+        uint32_t First = 0u;//@brief First index, or first vertex when IsIndexed is false
+        int32_t BaseVertex = 0;
+        bool IsIndexed = true;
+    };
+
+    /**
+     * @brief Draws and binds issued by one CommandBucket::Submit
+     */
+    struct BucketSubmitStats
+    {
+        uint32_t Draws = 0u;
+        uint32_t PipelineBinds = 0u;
+        uint32_t MaterialBinds = 0u;
+        uint32_t GeometryBinds = 0u;
+        uint32_t RedundantBindsSkipped = 0u;
+    };
+
+    /**
+     * @brief A linear arena of draw packets owned by a single recording thread. Memory is allocated in fixed
+     * blocks that are never moved and are kept across Reset, so steady-state recording does not allocate.
+     */
+    class CommandBuffer
+    {
+    public:
+        static constexpr uint32_t BLOCK_SIZE = 4096u;
+
+        CommandBuffer() = default;
+        ~CommandBuffer() = default;
+
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /**
+         * @brief Appends a packet as is. Prefer DrawIndexed and Draw, which build the key from the packet's own
+         * pipeline and material so the two cannot disagree.
+         */
+        void Record(const DrawPacket& packet)
+        {
+            const auto block = m_count / BLOCK_SIZE;
+            if (block == m_blocks.size())
+            {
+                m_blocks.emplace_back(std::make_unique<DrawPacket[]>(BLOCK_SIZE));
+            }
+            m_blocks[block][m_count % BLOCK_SIZE] = packet;
+            ++m_count;
+        }
+
+        /**
+         * @brief Records an indexed draw, sorted by MakeSortKey(layer, pipeline, material, depth)
+         * @param depth A depth from QuantizeDepth
+         */
+        void DrawIndexed(uint8_t layer, uint32_t depth, StateHandle pipeline, uint32_t material, uint32_t geometry,
+            uint32_t indexCount, uint32_t firstIndex = 0u, int32_t baseVertex = 0, uint32_t instanceCount = 1u)
+        {
+            Record(DrawPacket{ .Key = MakeSortKey(layer, pipeline, material, depth), .Pipeline = pipeline,
+                .Material = material, .Geometry = geometry, .Count = indexCount, .InstanceCount = instanceCount,
+                .First = firstIndex, .BaseVertex = baseVertex, .IsIndexed = true });
+        }
+
+        /**
+         * @brief Records a non-indexed draw, sorted by MakeSortKey(layer, pipeline, material, depth)
+         * @param depth A depth from QuantizeDepth
+         */
+        void Draw(uint8_t layer, uint32_t depth, StateHandle pipeline, uint32_t material, uint32_t geometry,
+            uint32_t vertexCount, uint32_t firstVertex = 0u, uint32_t instanceCount = 1u)
+        {
+            Record(DrawPacket{ .Key = MakeSortKey(layer, pipeline, material, depth), .Pipeline = pipeline,
+                .Material = material, .Geometry = geometry, .Count = vertexCount, .InstanceCount = instanceCount,
+                .First = firstVertex, .IsIndexed = false });
+        }
+
+        [[nodiscard]] auto Size() const noexcept -> uint32_t
+        {
+            return m_count;
+        }
+
+        [[nodiscard]] auto operator[](uint32_t index) const noexcept -> const DrawPacket&
+        {
+            return m_blocks[index / BLOCK_SIZE][index % BLOCK_SIZE];
+        }
+
+        /**
+         * @brief Forgets the recorded packets, keeping the memory for the next frame
+         */
+        void Reset() noexcept
+        {
+            m_count = 0u;
+        }
+
+    private:
+        std::vector<std::unique_ptr<DrawPacket[]>> m_blocks;
+        uint32_t m_count = 0u;
+    };
+
+    /**
+     * @brief Collects draw packets recorded in parallel and replays them onto a context in sort key order.
+     *
+     * Each recording thread uses its own CommandBuffer (e.g. indexed by LS::Jobs worker index + 1, with 0 for the
+     * main thread). Submit merges the buffers, radix sorts the keys (stable, so equal keys keep their recording
+     * order) and skips binds that match the previously bound pipeline, material or geometry.
+     */
+    class CommandBucket
+    {
+    public:
+        explicit CommandBucket(uint32_t bufferCount);
+        ~CommandBucket() = default;
+
+        CommandBucket(const CommandBucket&) = delete;
+        CommandBucket& operator=(const CommandBucket&) = delete;
+
+        /**
+         * @brief The buffer for one recording thread. Only one thread may record into a buffer at a time.
+         */
+        [[nodiscard]] auto GetBuffer(uint32_t index) noexcept -> CommandBuffer&
+        {
+            return *m_buffers[index];
+        }
+
+        [[nodiscard]] auto GetBufferCount() const noexcept -> uint32_t
+        {
+            return static_cast<uint32_t>(m_buffers.size());
+        }
+
+        [[nodiscard]] auto Size() const noexcept -> uint32_t;
+
+        /**
+         * @brief Sorts every recorded packet and replays it onto @p context. Recording must have finished.
+         */
+        auto Submit(ILSContext& context) -> BucketSubmitStats;
+
+        /**
+         * @brief Merges and sorts the recorded packets without replaying them. GetSorted then walks the result.
+         */
+        void Sort();
+
+        /**
+         * @brief The packet at @p index in sort order, valid after Sort or Submit until the next Reset
+         */
+        [[nodiscard]] auto GetSorted(uint32_t index) const noexcept -> const DrawPacket&
+        {
+            return *m_sources[m_values[index]];
+        }
+
+        /**
+         * @brief Clears every buffer for the next frame
+         */
+        void Reset() noexcept;
+
+    private:
+        std::vector<Ref<CommandBuffer>> m_buffers;
+
+        // Sort scratch, kept between frames
+        std::vector<const DrawPacket*> m_sources;
+        std::vector<uint64_t> m_keys;
+        std::vector<uint64_t> m_keysTemp;
+        std::vector<uint32_t> m_values;
+        std::vector<uint32_t> m_valuesTemp;
+    };
+
+    /**
+     * @brief A context that draws nothing and counts what it is asked to do. Useful for tests, headless runs and
+     * for measuring how many state changes a frame would issue.
+     */
+    class RecordingContext : public ILSContext
+    {
+    public:
+        struct Counters
+        {
+            uint32_t PipelinePrepares = 0u;
+            uint32_t PipelineBinds = 0u;
+            uint32_t MaterialBinds = 0u;
+            uint32_t GeometryBinds = 0u;
+            uint32_t Draws = 0u;
+            uint64_t Primitives = 0u;//@brief Sum of index/vertex counts times instances
+            uint32_t Clears = 0u;
+            uint32_t Presents = 0u;
+
+            [[nodiscard]] auto StateChanges() const noexcept -> uint32_t
+            {
+                return PipelinePrepares + PipelineBinds + MaterialBinds + GeometryBinds;
+            }
+        };
+
+        RecordingContext() = default;
+        ~RecordingContext() = default;
+
+        void PreparePipeline([[maybe_unused]] Ref<PipelineDescriptor> pipeline) noexcept override
+        {
+            ++m_counters.PipelinePrepares;
+        }
+
+        void Clear([[maybe_unused]] const std::array<float, 4>& color) noexcept override
+        {
+            ++m_counters.Clears;
+        }
+
+        void Present([[maybe_unused]] uint32_t syncInterval) noexcept override
+        {
+            ++m_counters.Presents;
+        }
+
+        void Finish() noexcept override
+        {
+        }
+
+        void BindPipeline(StateHandle pipeline) noexcept override
+        {
+            ++m_counters.PipelineBinds;
+            m_pipeline = pipeline;
+        }
+
+        void BindMaterial(uint32_t material) noexcept override
+        {
+            ++m_counters.MaterialBinds;
+            m_material = material;
+        }
+
+        void BindGeometry(uint32_t geometry) noexcept override
+        {
+            ++m_counters.GeometryBinds;
+            m_geometry = geometry;
+        }
+
+        void Draw(uint32_t vertexCount, uint32_t instanceCount, [[maybe_unused]] uint32_t firstVertex) noexcept override
+        {
+            ++m_counters.Draws;
+            m_counters.Primitives += static_cast<uint64_t>(vertexCount) * instanceCount;
+        }
+
+        void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, [[maybe_unused]] uint32_t firstIndex,
+            [[maybe_unused]] int32_t baseVertex) noexcept override
+        {
+            ++m_counters.Draws;
+            m_counters.Primitives += static_cast<uint64_t>(indexCount) * instanceCount;
+        }
+
+        [[nodiscard]] auto GetCounters() const noexcept -> const Counters&
+        {
+            return m_counters;
+        }
+
+        [[nodiscard]] auto GetBoundPipeline() const noexcept -> StateHandle
+        {
+            return m_pipeline;
+        }
+
+        [[nodiscard]] auto GetBoundMaterial() const noexcept -> uint32_t
+        {
+            return m_material;
+        }
+
+        [[nodiscard]] auto GetBoundGeometry() const noexcept -> uint32_t
+        {
+            return m_geometry;
+        }
+
+        void ResetCounters() noexcept
+        {
+            m_counters = {};
+        }
+
+    private:
+        Counters m_counters;
+        StateHandle m_pipeline = INVALID_STATE_HANDLE;
+        uint32_t m_material = UINT32_MAX;
+        uint32_t m_geometry = UINT32_MAX;
+    };
+}
+
+module : private;
+
+namespace
+{
+    constexpr uint32_t RADIX_BITS = 8u;
+    constexpr uint32_t RADIX_BUCKETS = 1u << RADIX_BITS;
+    constexpr uint32_t RADIX_PASSES = 64u / RADIX_BITS;
+
+    /**
+     * @brief Stable LSD radix sort of keys and their values. All histograms are built in one read, and passes where
+     * every key has the same digit (e.g. a single layer) are skipped.
+     */
+    void RadixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values,
+        std::vector<uint64_t>& keysTemp, std::vector<uint32_t>& valuesTemp)
+    {
+        const auto count = keys.size();
+        if (count < 2u)
+            return;
+
+        std::array<std::array<uint32_t, RADIX_BUCKETS>, RADIX_PASSES> histograms{};
+        for (const auto key : keys)
+        {
+            for (auto pass = 0u; pass < RADIX_PASSES; ++pass)
+            {
+                ++histograms[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1u)];
+            }
+        }
+
+        keysTemp.resize(count);
+        valuesTemp.resize(count);
+        for (auto pass = 0u; pass < RADIX_PASSES; ++pass)
+        {
+            auto& histogram = histograms[pass];
+            const auto shift = pass * RADIX_BITS;
+            if (histogram[(keys[0] >> shift) & (RADIX_BUCKETS - 1u)] == count)
+                continue;
+
+            // Exclusive prefix sum gives each digit's first output slot
+            uint32_t offset = 0u;
+            for (auto& bucket : histogram)
+            {
+                const auto size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0u; i < count; ++i)
+            {
+                const auto slot = histogram[(keys[i] >> shift) & (RADIX_BUCKETS - 1u)]++;
+                keysTemp[slot] = keys[i];
+                valuesTemp[slot] = values[i];
+            }
+            keys.swap(keysTemp);
+            values.swap(valuesTemp);
+        }
+    }
+}
+
+namespace LS
+{
+    CommandBucket::CommandBucket(uint32_t bufferCount)
+    {
+        bufferCount = std::max(bufferCount, 1u);
+        m_buffers.reserve(bufferCount);
+        for (auto i = 0u; i < bufferCount; ++i)
+        {
+            m_buffers.emplace_back(std::make_unique<CommandBuffer>());
+        }
+    }
+
+    auto CommandBucket::Size() const noexcept -> uint32_t
+    {
+        uint32_t count = 0u;
+        for (const auto& buffer : m_buffers)
+        {
+            count += buffer->Size();
+        }
+        return count;
+    }
+
+    void CommandBucket::Sort()
+    {
+        const auto count = Size();
+        m_sources.resize(count);
+        m_keys.resize(count);
+        m_values.resize(count);
+
+        uint32_t index = 0u;
+        for (const auto& buffer : m_buffers)
+        {
+            for (auto i = 0u; i < buffer->Size(); ++i, ++index)
+            {
+                const auto& packet = (*buffer)[i];
+                m_sources[index] = &packet;
+                m_keys[index] = packet.Key;
+                m_values[index] = index;
+            }
+        }
+
+        RadixSort(m_keys, m_values, m_keysTemp, m_valuesTemp);
+    }
+
+    auto CommandBucket::Submit(ILSContext& context) -> BucketSubmitStats
+    {
+        Sort();
+
+        BucketSubmitStats stats;
+        auto pipeline = INVALID_STATE_HANDLE;
+        auto material = UINT32_MAX;
+        auto geometry = UINT32_MAX;
+        auto isFirst = true;
+
+        for (auto i = 0u; i < m_values.size(); ++i)
+        {
+            const auto& packet = GetSorted(i);
+            if (isFirst || packet.Pipeline != pipeline)
+            {
+                context.BindPipeline(packet.Pipeline);
+                pipeline = packet.Pipeline;
+                ++stats.PipelineBinds;
+            }
+            else
+            {
+                ++stats.RedundantBindsSkipped;
+            }
+
+            if (isFirst || packet.Material != material)
+            {
+                context.BindMaterial(packet.Material);
+                material = packet.Material;
+                ++stats.MaterialBinds;
+            }
+            else
+            {
+                ++stats.RedundantBindsSkipped;
+            }
+
+            if (isFirst || packet.Geometry != geometry)
+            {
+                context.BindGeometry(packet.Geometry);
+                geometry = packet.Geometry;
+                ++stats.GeometryBinds;
+            }
+            else
+            {
+                ++stats.RedundantBindsSkipped;
+            }
+            isFirst = false;
+
+            if (packet.IsIndexed)
+            {
+                context.DrawIndexed(packet.Count, packet.InstanceCount, packet.First, packet.BaseVertex);
+            }
+            else
+            {
+                context.Draw(packet.Count, packet.InstanceCount, packet.First);
+            }
+            ++stats.Draws;
+        }
+        return stats;
+    }
+
+    void CommandBucket::Reset() noexcept
+    {
+        for (auto& buffer : m_buffers)
+        {
+            buffer->Reset();
+        }
+        m_sources.clear();
+        m_keys.clear();
+        m_values.clear();
+    }
+}
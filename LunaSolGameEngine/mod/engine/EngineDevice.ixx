@@ -7,6 +7,8 @@ module;
 #include <unordered_map>
 #include <string>
 #include <array>
+#include <bit>
+#include <limits>
 export module Engine.LSDevice;
 
 import Engine.LSWindow;
@@ -147,11 +149,15 @@ namespace LS
             BLEND_OPERATION BlendOp;
             BLEND_FACTOR Src;
             BLEND_FACTOR Dest;
+
+            bool operator==(const Channel&) const = default;
         };
 
         Channel Rgb;
         Channel Alpha;
         COLOR_CHANNEL_MASK Mask;
+
+        bool operator==(const BlendOps&) const = default;
     };
 
     /**
@@ -167,9 +173,13 @@ namespace LS
             bool IsEnabled;
             // @brief Pointer to each Render Target support (at least one required)
             std::vector<BlendOps> Targets;
+
+            bool operator==(const Custom&) const = default;
         };
 
         Custom CustomOp;
+
+        bool operator==(const LSBlendState&) const = default;
     };
 
     /**
@@ -239,6 +249,8 @@ namespace LS
         float MipLODBias = 0.0f;
         TextureRenderState TextureRenderState;
         EVAL_COMPARE Evaluator;
+
+        bool operator==(const LSSamplerState&) const = default;
     };
 
     export enum class CPU_ACCESS_FLAG 
@@ -276,17 +288,16 @@ namespace LS
         }
     };
 
+    /**
+     * @brief Hasher for the pipeline sub-states (RasterizerInfo, DepthStencil, LSBlendState, LSSamplerState)
+     * for use with the std unordered containers.
+     */
     export struct LSDrawStateHashFunc
     {
         template <typename T = LS::RasterizerInfo>
         std::size_t operator()(T const& t) const noexcept
         {
-            std::size_t h1 = LS::Utils::HashEnum(t.Fill);
-            std::size_t h2 = t.IsFrontCounterClockwise ? 1 : 0;
-            std::size_t h3 = LS::Utils::HashEnum(t.Cull);
-            std::size_t h4 = t.IsDepthClipEnabled ? 1 : 0;
-
-            return h1 ^ h2 ^ h3 ^ h4;
+            return static_cast<std::size_t>(HashState(t));
         }
     };
 
@@ -327,12 +338,167 @@ namespace LS
             DEPTH_STENCIL_OPS StencilPassDepthFailOp; // @brief stencil test passes but depth test fails
             DEPTH_STENCIL_OPS BothPassOp;             // @brief Stencil AND Depth Pass 
             EVAL_COMPARE StencilTestFunc;             // @brief function to perform for this stencil operation
+
+            bool operator==(const DepthStencilOps&) const = default;
         };
 
         DepthStencilOps FrontFace; // @brief Operations for front facing pixels
         DepthStencilOps BackFace;  // @brief Operations for back facing pixels
+
+        bool operator==(const DepthStencil&) const = default;
     };
 
+    // State Canonicalization & Hashing //
+    // Fields the GPU ignores for a given configuration (e.g. the depth function when depth testing is off) are reset
+    // to fixed values so that states which behave the same compare and hash the same.
+
+    /**
+     * @brief Every rasterizer field affects rendering, so the canonical form is the state itself
+     */
+    export constexpr auto Canonicalize(const RasterizerInfo& state) noexcept -> RasterizerInfo
+    {
+        return state;
+    }
+
+    /**
+     * @brief Resets the depth fields when depth testing is disabled and the stencil fields when stencil is disabled
+     */
+    export constexpr auto Canonicalize(const DepthStencil& state) noexcept -> DepthStencil
+    {
+        constexpr DepthStencil::DepthStencilOps defaultOps{
+            .StencilFailOp = DEPTH_STENCIL_OPS::KEEP,
+            .StencilPassDepthFailOp = DEPTH_STENCIL_OPS::KEEP,
+            .BothPassOp = DEPTH_STENCIL_OPS::KEEP,
+            .StencilTestFunc = EVAL_COMPARE::ALWAYS_PASS
+        };
+
+        auto out = state;
+        if (!out.IsDepthEnabled)
+        {
+            out.DepthBufferWriteAll = false;
+            out.DepthComparison = EVAL_COMPARE::NEVER_PASS;
+        }
+
+        if (!out.IsStencilEnabled)
+        {
+            out.StencilWriteMask = 0xFF;
+            out.StencilReadMask = 0xFF;
+            out.FrontFace = defaultOps;
+            out.BackFace = defaultOps;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Drops the custom operations of the built-in blend types, disabled custom blends and the
+     * targets past the first one when independent blending is off
+     */
+    export inline auto Canonicalize(const LSBlendState& state) -> LSBlendState
+    {
+        if (state.BlendType != BlendType::CUSTOM_BLEND)
+        {
+            return LSBlendState{ .BlendType = state.BlendType, .CustomOp = {} };
+        }
+
+        auto out = state;
+        if (!out.CustomOp.IsEnabled)
+        {
+            out.CustomOp.IsIndepdentBlend = false;
+            out.CustomOp.Targets.clear();
+        }
+        else if (!out.CustomOp.IsIndepdentBlend && out.CustomOp.Targets.size() > 1u)
+        {
+            out.CustomOp.Targets.resize(1u);
+        }
+        return out;
+    }
+
+    export constexpr auto Canonicalize(const LSSamplerState& state) noexcept -> LSSamplerState
+    {
+        return state;
+    }
+
+    /**
+     * @brief 64-bit key of a rasterizer state. Hash the canonical form to merge equivalent states.
+     */
+    export constexpr auto HashState(const RasterizerInfo& state) noexcept -> uint64_t
+    {
+        const uint64_t packed = static_cast<uint64_t>(static_cast<uint8_t>(state.Fill))
+            | static_cast<uint64_t>(static_cast<uint8_t>(state.Cull)) << 8
+            | static_cast<uint64_t>(state.IsFrontCounterClockwise) << 16
+            | static_cast<uint64_t>(state.IsDepthClipEnabled) << 24;
+        return LS::Utils::HashCombine(0x5241'5354'4552'0001ull, packed);
+    }
+
+    export constexpr auto HashState(const DepthStencil& state) noexcept -> uint64_t
+    {
+        const auto packOps = [](const DepthStencil::DepthStencilOps& ops) -> uint64_t
+            {
+                return static_cast<uint64_t>(ops.StencilFailOp)
+                    | static_cast<uint64_t>(ops.StencilPassDepthFailOp) << 8
+                    | static_cast<uint64_t>(ops.BothPassOp) << 16
+                    | static_cast<uint64_t>(ops.StencilTestFunc) << 24;
+            };
+
+        const uint64_t packed = static_cast<uint64_t>(state.IsDepthEnabled)
+            | static_cast<uint64_t>(state.DepthBufferWriteAll) << 8
+            | static_cast<uint64_t>(state.DepthComparison) << 16
+            | static_cast<uint64_t>(state.IsStencilEnabled) << 24
+            | static_cast<uint64_t>(state.StencilWriteMask) << 32
+            | static_cast<uint64_t>(state.StencilReadMask) << 40;
+        const auto hash = LS::Utils::HashCombine(0x4445'5054'4853'0001ull, packed);
+        return LS::Utils::HashCombine(hash, packOps(state.FrontFace) | packOps(state.BackFace) << 32);
+    }
+
+    export constexpr auto HashState(const LSBlendState& state) noexcept -> uint64_t
+    {
+        const uint64_t packed = static_cast<uint64_t>(state.BlendType)
+            | static_cast<uint64_t>(state.CustomOp.IsAlphaSampling) << 32
+            | static_cast<uint64_t>(state.CustomOp.IsIndepdentBlend) << 40
+            | static_cast<uint64_t>(state.CustomOp.IsEnabled) << 48;
+        auto hash = LS::Utils::HashCombine(0x424C'454E'4453'0001ull, packed);
+        for (const auto& target : state.CustomOp.Targets)
+        {
+            const auto packChannel = [](const BlendOps::Channel& channel) -> uint64_t
+                {
+                    return static_cast<uint64_t>(channel.BlendOp)
+                        | static_cast<uint64_t>(channel.Src) << 8
+                        | static_cast<uint64_t>(channel.Dest) << 16;
+                };
+            hash = LS::Utils::HashCombine(hash, packChannel(target.Rgb) | packChannel(target.Alpha) << 24
+                | static_cast<uint64_t>(target.Mask) << 48);
+        }
+        return hash;
+    }
+
+    export constexpr auto HashState(const LSSamplerState& state) noexcept -> uint64_t
+    {
+        // +0 and -0 compare equal so they must hash the same
+        const auto floatBits = [](float value) -> uint64_t
+            {
+                return value == 0.0f ? 0u : std::bit_cast<uint32_t>(value);
+            };
+
+        const auto& tex = state.TextureRenderState;
+        auto hash = LS::Utils::HashCombine(0x5341'4D50'4C52'0001ull, static_cast<uint64_t>(state.AnisotropyLevel)
+            | static_cast<uint64_t>(state.Evaluator) << 32);
+        hash = LS::Utils::HashCombine(hash, floatBits(state.MinLOD) | floatBits(state.MaxLOD) << 32);
+        hash = LS::Utils::HashCombine(hash, floatBits(state.MipLODBias));
+        hash = LS::Utils::HashCombine(hash, static_cast<uint64_t>(tex.METHOD)
+            | static_cast<uint64_t>(tex.MIN_FILTER) << 8
+            | static_cast<uint64_t>(tex.MAG_FILTER) << 16
+            | static_cast<uint64_t>(tex.MIP_FILTER) << 24
+            | static_cast<uint64_t>(tex.FILTER_TYPE) << 32
+            | static_cast<uint64_t>(tex.ADDRESS_U) << 40
+            | static_cast<uint64_t>(tex.ADDRESS_V) << 48
+            | static_cast<uint64_t>(tex.ADDRESS_W) << 56);
+        for (const auto channel : tex.BorderColor)
+        {
+            hash = LS::Utils::HashCombine(hash, floatBits(channel));
+        }
+        return hash;
+    }
+
     export struct LSDeviceSettings
     {
         uint32_t FPSTarget = 60;
@@ -385,8 +551,17 @@ namespace LS
     {
         uint16_t BindSlot;
         LSSamplerState Sampler;
+
+        bool operator==(const SamplerMap&) const = default;
     };
 
+    /**
+     * @brief A small, stable integer naming an interned state (see LS::PipelineCache). Backends can index their
+     * native state objects with it.
+     */
+    export using StateHandle = uint32_t;
+    export constexpr StateHandle INVALID_STATE_HANDLE = UINT32_MAX;
+
     // Pipeline State //
     /**
      * @brief A system for the different states that construct a graphics pipeline
@@ -408,6 +583,7 @@ namespace LS
         LSBlendState BlendState;
         DepthStencil DepthStencil;
         ShaderPipeline Shaders;
+        StateHandle ShaderSet = INVALID_STATE_HANDLE; // @brief From PipelineCache::InternShaders, when set the cache keys by it instead of hashing Shaders
         LSShaderInputSignature ShaderSignature;
         PRIMITIVE_TOPOLOGY Topology;
         LSTextureInfo RenderTarget;
@@ -449,6 +625,26 @@ namespace LS
         virtual void Present(uint32_t syncInterval) noexcept = 0;
 
         virtual void Finish() noexcept = 0;
+
+        // Handle based binding, used when replaying sorted draw packets (see LS::CommandBucket) //
+
+        /**
+         * @brief Binds the pipeline state interned under @p pipeline
+         */
+        virtual void BindPipeline(StateHandle pipeline) noexcept = 0;
+
+        /**
+         * @brief Binds the shader resources (textures, samplers, constant buffers) registered as @p material
+         */
+        virtual void BindMaterial(uint32_t material) noexcept = 0;
+
+        /**
+         * @brief Binds the vertex and index buffers registered as @p geometry
+         */
+        virtual void BindGeometry(uint32_t geometry) noexcept = 0;
+
+        virtual void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex) noexcept = 0;
+        virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex) noexcept = 0;
     };
 
     /**
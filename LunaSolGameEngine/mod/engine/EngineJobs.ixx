@@ -0,0 +1,537 @@
+module;
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+export module Engine.Jobs;
+import Engine.Defines;
+import Engine.EngineCodes;
+
+export namespace LS::Jobs
+{
+    class JobSystem;
+
+    /**
+     * @brief Counts the jobs of a group that have not finished yet. Jobs submitted with a counter increment it
+     * before they are queued and decrement it when they complete, so a counter can be waited on or used as a
+     * dependency for continuations (see JobSystem::RunAfter).
+     *
+     * A counter must outlive every job and continuation that references it. It may be reused once it reaches zero.
+     */
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        ~JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        [[nodiscard]] auto IsDone() const noexcept -> bool
+        {
+            return m_pending.load(std::memory_order_acquire) == 0u;
+        }
+
+        [[nodiscard]] auto Pending() const noexcept -> uint32_t
+        {
+            return m_pending.load(std::memory_order_acquire);
+        }
+
+    private:
+        friend class JobSystem;
+
+        struct Continuation
+        {
+            std::function<void()> Task;
+            JobCounter* Counter;
+        };
+
+        std::atomic<uint32_t> m_pending = 0u;
+        std::mutex m_lock;
+        std::vector<Continuation> m_continuations;
+    };
+
+    /**
+     * @brief A work-stealing task scheduler. Each worker owns a deque; it pushes and pops its own work from the back
+     * (LIFO, cache warm) while idle workers steal from the front of the others (FIFO, oldest and largest work first).
+     * Threads that are not workers submit round-robin into the worker deques.
+     *
+     * Waiting on a counter never parks a worker: Wait() keeps running queued jobs until the counter drops to zero,
+     * so jobs may spawn and wait on other jobs (e.g. nested ParallelFor) without deadlocking the pool.
+     *
+     * Jobs must not throw.
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * @brief Starts the worker threads
+         * @param workerCount Number of workers, 0 uses the hardware concurrency minus the calling thread
+         */
+        explicit JobSystem(uint32_t workerCount);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Queues a job
+         * @param task The work to do
+         * @param counter Optional counter to increment now and decrement when the job has finished
+         */
+        void Run(std::function<void()> task, JobCounter* counter = nullptr) noexcept;
+
+        /**
+         * @brief Queues a job once every job tracked by @p dependency has finished (a continuation).
+         * If the dependency is already done the job is queued immediately.
+         * @param dependency The group that must finish first
+         * @param task The work to do
+         * @param counter Optional counter to increment now and decrement when the job has finished
+         */
+        void RunAfter(JobCounter& dependency, std::function<void()> task, JobCounter* counter = nullptr) noexcept;
+
+        /**
+         * @brief Returns once @p counter reaches zero. The calling thread runs queued jobs while it waits.
+         */
+        void Wait(JobCounter& counter) noexcept;
+
+        /**
+         * @brief Splits [begin, end) into chunks and runs them across the workers and the calling thread,
+         * returning once every chunk has finished.
+         * @param func Called as func(first, last) for each chunk, or func(index) for every index
+         * @param minChunkSize Smallest number of indices worth a job of its own
+         */
+        template<class Func>
+        void ParallelFor(size_t begin, size_t end, Func&& func, size_t minChunkSize = 1u) noexcept;
+
+        [[nodiscard]] auto GetWorkerCount() const noexcept -> uint32_t
+        {
+            return static_cast<uint32_t>(m_queues.size());
+        }
+
+        /**
+         * @brief The index of the calling worker in this system, or -1 if the caller is not one of its workers
+         */
+        [[nodiscard]] auto GetWorkerIndex() const noexcept -> int32_t;
+
+    private:
+        struct Job
+        {
+            std::function<void()> Task;
+            JobCounter* Counter = nullptr;
+        };
+
+        struct alignas(64) WorkerQueue
+        {
+            std::mutex Lock;
+            std::deque<Job> Jobs;
+        };
+
+        void Push(Job job) noexcept;
+        [[nodiscard]] auto TryPop(int32_t worker, Job& job) noexcept -> bool;
+        [[nodiscard]] auto TryRunOne() noexcept -> bool;
+        void Execute(Job& job) noexcept;
+        void Complete(JobCounter& counter) noexcept;
+        void WorkerLoop(uint32_t index) noexcept;
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        alignas(64) std::atomic<size_t> m_queued = 0u;
+        std::atomic<uint32_t> m_nextQueue = 0u;
+        alignas(64) std::atomic<uint32_t> m_epoch = 0u;
+        std::atomic<uint32_t> m_sleepers = 0u;
+        std::atomic<bool> m_running = true;
+    };
+
+    /**
+     * @brief The engine wide scheduler, created by InitJobs. The free functions below fall back to running on
+     * the calling thread when it has not been initialized.
+     */
+    Ref<JobSystem> Scheduler;
+
+    /**
+     * @brief Starts the engine wide scheduler
+     * @param threadCount Number of worker threads, 0 uses the hardware concurrency minus the calling thread
+     */
+    [[nodiscard]] auto InitJobs(uint32_t threadCount) noexcept -> LS::System::ErrorCode;
+
+    /**
+     * @brief Finishes all queued jobs and stops the engine wide scheduler
+     */
+    void ShutdownJobs() noexcept;
+
+    void Run(std::function<void()> task, JobCounter* counter = nullptr) noexcept;
+    void RunAfter(JobCounter& dependency, std::function<void()> task, JobCounter* counter = nullptr) noexcept;
+    void Wait(JobCounter& counter) noexcept;
+
+    template<class Func>
+    void ParallelFor(size_t begin, size_t end, Func&& func, size_t minChunkSize = 1u) noexcept
+    {
+        if (Scheduler)
+        {
+            Scheduler->ParallelFor(begin, end, std::forward<Func>(func), minChunkSize);
+            return;
+        }
+
+        if (begin >= end)
+            return;
+
+        if constexpr (std::invocable<Func&, size_t, size_t>)
+        {
+            func(begin, end);
+        }
+        else
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                func(i);
+            }
+        }
+    }
+
+    template<class Func>
+    void JobSystem::ParallelFor(size_t begin, size_t end, Func&& func, size_t minChunkSize) noexcept
+    {
+        static_assert(std::invocable<Func&, size_t, size_t> || std::invocable<Func&, size_t>,
+            "ParallelFor expects func(first, last) or func(index)");
+
+        if (begin >= end)
+            return;
+
+        const auto count = end - begin;
+        minChunkSize = std::max<size_t>(minChunkSize, 1u);
+
+        // A few chunks per thread (workers + caller) leaves room to balance uneven work through stealing
+        const auto maxChunks = (static_cast<size_t>(GetWorkerCount()) + 1u) * 4u;
+        const auto chunkCount = std::clamp<size_t>(count / minChunkSize, 1u, maxChunks);
+        const auto chunkSize = (count + chunkCount - 1u) / chunkCount;
+
+        auto runChunk = [&func, begin, end, chunkSize](size_t chunk)
+            {
+                const auto first = begin + chunk * chunkSize;
+                const auto last = std::min(first + chunkSize, end);
+                if constexpr (std::invocable<Func&, size_t, size_t>)
+                {
+                    func(first, last);
+                }
+                else
+                {
+                    for (auto i = first; i < last; ++i)
+                    {
+                        func(i);
+                    }
+                }
+            };
+
+        JobCounter counter;
+        for (size_t chunk = 1u; chunk * chunkSize < count; ++chunk)
+        {
+            Run([&runChunk, chunk]() { runChunk(chunk); }, &counter);
+        }
+        runChunk(0u);
+        Wait(counter);
+    }
+}
+
+module : private;
+
+namespace
+{
+    thread_local const LS::Jobs::JobSystem* t_owner = nullptr;
+    thread_local int32_t t_workerIndex = -1;
+
+    // Spins before a thread with nothing to do goes to sleep
+    constexpr uint32_t IDLE_SPIN_COUNT = 64u;
+}
+
+namespace LS::Jobs
+{
+    JobSystem::JobSystem(uint32_t workerCount)
+    {
+        if (workerCount == 0u)
+        {
+            workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+        }
+
+        m_queues.reserve(workerCount);
+        for (auto i = 0u; i < workerCount; ++i)
+        {
+            m_queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+
+        m_workers.reserve(workerCount);
+        for (auto i = 0u; i < workerCount; ++i)
+        {
+            m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        m_running.store(false);
+        m_epoch.fetch_add(1u);
+        m_epoch.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void JobSystem::Run(std::function<void()> task, JobCounter* counter) noexcept
+    {
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1u, std::memory_order_relaxed);
+        }
+        Push(Job{ .Task = std::move(task), .Counter = counter });
+    }
+
+    void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> task, JobCounter* counter) noexcept
+    {
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        {
+            // Complete() drops the counter to zero under this lock, so the check and the append cannot race it
+            std::scoped_lock lock(dependency.m_lock);
+            if (dependency.m_pending.load(std::memory_order_acquire) != 0u)
+            {
+                dependency.m_continuations.push_back(JobCounter::Continuation{ .Task = std::move(task), .Counter = counter });
+                return;
+            }
+        }
+        Push(Job{ .Task = std::move(task), .Counter = counter });
+    }
+
+    void JobSystem::Wait(JobCounter& counter) noexcept
+    {
+        const auto isWorker = t_owner == this;
+        auto idle = 0u;
+        while (!counter.IsDone())
+        {
+            if (TryRunOne())
+            {
+                idle = 0u;
+                continue;
+            }
+
+            if (++idle < IDLE_SPIN_COUNT || isWorker)
+            {
+                // Workers keep looking for jobs to help with instead of parking
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto pending = counter.m_pending.load(std::memory_order_acquire);
+            if (pending != 0u)
+            {
+                counter.m_pending.wait(pending, std::memory_order_acquire);
+            }
+        }
+
+        // The last job may still be inside Complete(); once we own the lock it has let go of the counter
+        std::scoped_lock lock(counter.m_lock);
+    }
+
+    auto JobSystem::GetWorkerIndex() const noexcept -> int32_t
+    {
+        return t_owner == this ? t_workerIndex : -1;
+    }
+
+    void JobSystem::Push(Job job) noexcept
+    {
+        const auto worker = GetWorkerIndex();
+        const auto index = worker >= 0 ? static_cast<uint32_t>(worker)
+            : m_nextQueue.fetch_add(1u, std::memory_order_relaxed) % GetWorkerCount();
+
+        auto& queue = *m_queues[index];
+        {
+            std::scoped_lock lock(queue.Lock);
+            queue.Jobs.push_back(std::move(job));
+        }
+        m_queued.fetch_add(1u);
+
+        m_epoch.fetch_add(1u);
+        if (m_sleepers.load() > 0u)
+        {
+            m_epoch.notify_one();
+        }
+    }
+
+    auto JobSystem::TryPop(int32_t worker, Job& job) noexcept -> bool
+    {
+        const auto count = GetWorkerCount();
+        if (worker >= 0)
+        {
+            auto& own = *m_queues[worker];
+            std::scoped_lock lock(own.Lock);
+            if (!own.Jobs.empty())
+            {
+                job = std::move(own.Jobs.back());
+                own.Jobs.pop_back();
+                return true;
+            }
+        }
+
+        // Steal, starting from the neighbour so thieves spread out over the victims
+        const auto start = worker >= 0 ? static_cast<uint32_t>(worker) + 1u : m_nextQueue.load(std::memory_order_relaxed);
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto victim = (start + i) % count;
+            if (static_cast<int32_t>(victim) == worker)
+                continue;
+
+            auto& queue = *m_queues[victim];
+            std::unique_lock lock(queue.Lock, std::try_to_lock);
+            if (!lock.owns_lock() || queue.Jobs.empty())
+                continue;
+
+            job = std::move(queue.Jobs.front());
+            queue.Jobs.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    auto JobSystem::TryRunOne() noexcept -> bool
+    {
+        if (m_queued.load(std::memory_order_relaxed) == 0u)
+            return false;
+
+        Job job;
+        if (!TryPop(GetWorkerIndex(), job))
+            return false;
+
+        m_queued.fetch_sub(1u);
+        Execute(job);
+        return true;
+    }
+
+    void JobSystem::Execute(Job& job) noexcept
+    {
+        job.Task();
+        if (job.Counter)
+        {
+            Complete(*job.Counter);
+        }
+    }
+
+    void JobSystem::Complete(JobCounter& counter) noexcept
+    {
+        // Fast path while other jobs of the group are still running
+        auto pending = counter.m_pending.load(std::memory_order_relaxed);
+        while (pending > 1u)
+        {
+            if (counter.m_pending.compare_exchange_weak(pending, pending - 1u, std::memory_order_acq_rel))
+                return;
+        }
+
+        std::vector<JobCounter::Continuation> continuations;
+        {
+            std::scoped_lock lock(counter.m_lock);
+            if (counter.m_pending.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            {
+                continuations.swap(counter.m_continuations);
+                counter.m_pending.notify_all();
+            }
+        }
+
+        for (auto& continuation : continuations)
+        {
+            Push(Job{ .Task = std::move(continuation.Task), .Counter = continuation.Counter });
+        }
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index) noexcept
+    {
+        t_owner = this;
+        t_workerIndex = static_cast<int32_t>(index);
+
+        auto idle = 0u;
+        while (m_running.load(std::memory_order_relaxed) || m_queued.load() > 0u)
+        {
+            if (TryRunOne())
+            {
+                idle = 0u;
+                continue;
+            }
+
+            if (++idle < IDLE_SPIN_COUNT)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Announce the sleep before the final check so a Push that missed the flag is seen here instead
+            const auto epoch = m_epoch.load();
+            m_sleepers.fetch_add(1u);
+            if (m_queued.load() == 0u && m_running.load())
+            {
+                m_epoch.wait(epoch);
+            }
+            m_sleepers.fetch_sub(1u);
+            idle = 0u;
+        }
+
+        t_owner = nullptr;
+        t_workerIndex = -1;
+    }
+
+    auto InitJobs(uint32_t threadCount) noexcept -> LS::System::ErrorCode
+    {
+        try
+        {
+            Scheduler = std::make_unique<JobSystem>(threadCount);
+        }
+        catch (const std::exception& e)
+        {
+            Scheduler.reset();
+            return LS::System::CreateFailCode(e.what(), LS::ENGINE_CODE::OS_ERROR);
+        }
+        return LS::System::CreateSuccessCode();
+    }
+
+    void ShutdownJobs() noexcept
+    {
+        Scheduler.reset();
+    }
+
+    void Run(std::function<void()> task, JobCounter* counter) noexcept
+    {
+        if (!Scheduler)
+        {
+            task();
+            return;
+        }
+        Scheduler->Run(std::move(task), counter);
+    }
+
+    void RunAfter(JobCounter& dependency, std::function<void()> task, JobCounter* counter) noexcept
+    {
+        if (!Scheduler)
+        {
+            // Without a scheduler every job ran inline, so the dependency is already complete
+            task();
+            return;
+        }
+        Scheduler->RunAfter(dependency, std::move(task), counter);
+    }
+
+    void Wait(JobCounter& counter) noexcept
+    {
+        if (!Scheduler)
+            return;
+        Scheduler->Wait(counter);
+    }
+}
@@ -6,15 +6,27 @@ module;
 #include <string_view>
 #include <string>
 #include <format>
+#include <bit>
+#include <type_traits>
 #include <memory>
 #include <filesystem>
 #include <utility>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <locale>
+#include <mutex>
+#include <span>
+#include <thread>
 
 export module Engine.Logger;
 
 import Engine.EngineCodes;
 import LSDataLib;
 import Engine.Defines;
+import Util.StdUtils;
 
 export namespace LS::Log
 {
@@ -66,6 +78,24 @@ export namespace LS::Log
         }
     }
 
+    /**
+     * @brief What an AsyncLogger does when a producer finds the ring buffer full.
+    */
+    enum class LOG_OVERFLOW : uint8_t
+    {
+        BLOCK = 0,//@brief Spin/yield the calling thread until the writer thread frees a slot
+        DROP, //@brief Discard the message and increment the dropped message counter
+    };
+
+    /**
+     * @brief Settings for the asynchronous logging backend.
+    */
+    struct AsyncLogSettings
+    {
+        size_t Capacity = 8192;//@brief Number of messages the ring buffer can hold, rounded up to a power of two
+        LOG_OVERFLOW Overflow = LOG_OVERFLOW::DROP;
+    };
+
     class LSLogger
     {
     public:
@@ -86,11 +116,41 @@ export namespace LS::Log
 
         void SetLogLevel(LOG_LEVEL level) noexcept;
         auto GetLogLevel() noexcept -> LOG_LEVEL;
-        void Flush() noexcept;
+        virtual void Flush() noexcept;
+
+        /**
+         * @brief Number of messages discarded because the logger could not keep up. Always 0 for synchronous loggers.
+        */
+        virtual auto GetDroppedCount() const noexcept -> uint64_t;
+
+        /**
+         * @brief Number of messages that were cut short to fit the logger's buffer. Always 0 for synchronous loggers.
+        */
+        virtual auto GetTruncatedCount() const noexcept -> uint64_t;
 
     protected:
+        using TimePoint = std::chrono::system_clock::time_point;
+
+        /**
+         * @brief Entry point for every Print/PrintLine overload. Synchronous loggers format and write immediately,
+         * asynchronous loggers only capture the message and return.
+        */
+        virtual void Submit(LOG_LEVEL level, std::wstring_view msg, bool isNewLine) noexcept;
+        virtual void Submit(LOG_LEVEL level, std::string_view msg, bool isNewLine) noexcept;
+
+        /**
+         * @brief Appends the formatted message "{time} : [{level}] || {msg}" to @p out.
+        */
+        void Format(std::wstring& out, LOG_LEVEL level, TimePoint time, std::wstring_view msg, bool isNewLine) const;
+        /**
+         * @brief Writes already formatted text to the stream, serialized with m_streamLock.
+        */
+        void Write(std::wstring_view text) noexcept;
+
         LOG_LEVEL m_logLevel = LOG_LEVEL::DEBUG;
         std::wostream m_stream;
+        std::mutex m_streamLock;
+        const std::chrono::time_zone* m_zone = nullptr;
     };
 
     class FileLogger : public LSLogger
@@ -111,6 +171,80 @@ export namespace LS::Log
         auto Init() noexcept -> LS::System::ErrorCode;
     };
 
+    /**
+     * @brief Logger that defers all formatting and I/O to a background writer thread.
+     * 
+     * Producers claim a slot in a bounded lock-free ring buffer (multi-producer, single consumer), copy the raw
+     * timestamp, level and message text into it and return. The writer thread drains the ring in batches, does
+     * the timezone conversion and formatting, and issues one stream write and flush per batch.
+     * 
+     * Messages longer than MAX_MESSAGE_LENGTH wide characters are truncated, end in "..." and are counted by
+     * GetTruncatedCount(). Narrow strings are decoded as UTF-8.
+    */
+    class AsyncLogger : public LSLogger
+    {
+    public:
+        static constexpr size_t MAX_MESSAGE_LENGTH = 244;
+
+        /**
+         * @brief Logs to the console.
+        */
+        explicit AsyncLogger(AsyncLogSettings settings);
+        /**
+         * @brief Logs to @p file, creating its parent directories when needed.
+        */
+        AsyncLogger(std::filesystem::path file, AsyncLogSettings settings);
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        auto Init() noexcept -> LS::System::ErrorCode;
+
+        /**
+         * @brief Blocks until every message submitted before this call has been written and flushed.
+        */
+        void Flush() noexcept override;
+        auto GetDroppedCount() const noexcept -> uint64_t override;
+        auto GetTruncatedCount() const noexcept -> uint64_t override;
+
+    protected:
+        void Submit(LOG_LEVEL level, std::wstring_view msg, bool isNewLine) noexcept override;
+        void Submit(LOG_LEVEL level, std::string_view msg, bool isNewLine) noexcept override;
+
+    private:
+        struct Record
+        {
+            std::atomic<size_t> Sequence;
+            TimePoint::rep Ticks;
+            LOG_LEVEL Level;
+            bool IsNewLine;
+            uint16_t Length;
+            std::array<wchar_t, MAX_MESSAGE_LENGTH> Text;
+        };
+
+        template<class TChar>
+        void Enqueue(LOG_LEVEL level, std::basic_string_view<TChar> msg, bool isNewLine) noexcept;
+        void Start(size_t capacity);
+        void WakeWriter() noexcept;
+        void Run() noexcept;
+        auto Drain(std::wstring& batch) noexcept -> size_t;
+
+        std::wofstream m_fileStream;
+        LOG_OVERFLOW m_overflow;
+        std::unique_ptr<Record[]> m_records;
+        size_t m_mask = 0;
+
+        alignas(64) std::atomic<size_t> m_enqueuePos = 0;
+        alignas(64) std::atomic<size_t> m_dequeuePos = 0;
+        alignas(64) std::atomic<uint64_t> m_dropped = 0;
+        std::atomic<uint64_t> m_truncated = 0;
+        std::atomic<uint32_t> m_signal = 0;
+        std::atomic<bool> m_writerWaiting = false;
+        std::atomic<bool> m_running = true;
+        std::thread m_writer;
+    };
+
     Ref<LSLogger> Logger;
 
     void TraceError(std::wstring_view msg);
@@ -135,13 +269,83 @@ export namespace LS::Log
     */
     [[nodiscard]] auto InitLog(std::filesystem::path filepath, LOG_LEVEL level = LOG_LEVEL::DEBUG) noexcept -> LS::System::ErrorCode;
 
+    /**
+     * @brief Initialize an asynchronous log to the standard output. Formatting and writes happen on a background thread.
+     * @param settings Ring buffer capacity and the policy to use when it is full
+    */
+    [[nodiscard]] auto InitAsyncLog(AsyncLogSettings settings = {}, LOG_LEVEL level = LOG_LEVEL::DEBUG) noexcept -> LS::System::ErrorCode;
+
+    /**
+     * @brief Initialize an asynchronous log to a file. Formatting and writes happen on a background thread.
+     * @param filepath The file to use or create when logging
+     * @param settings Ring buffer capacity and the policy to use when it is full
+    */
+    [[nodiscard]] auto InitAsyncLog(std::filesystem::path filepath, AsyncLogSettings settings = {}, 
+        LOG_LEVEL level = LOG_LEVEL::DEBUG) noexcept -> LS::System::ErrorCode;
+
     void Flush() noexcept;
+
+    /**
+     * @brief Messages dropped by the active logger because its buffer was full.
+    */
+    auto GetDroppedCount() noexcept -> uint64_t;
+
+    /**
+     * @brief Messages cut short by the active logger because they did not fit its buffer.
+    */
+    auto GetTruncatedCount() noexcept -> uint64_t;
 }
 
 module : private;
 
+namespace
+{
+    /**
+     * @brief Replaces the end of a truncated message with "..." without splitting a UTF-16 surrogate pair
+     * @return The new length of the message
+    */
+    auto MarkTruncated(std::span<wchar_t> text, size_t length) noexcept -> size_t
+    {
+        constexpr std::wstring_view ELLIPSIS = L"...";
+        length = std::min(length, text.size() - ELLIPSIS.size());
+        if (length > 0 && text[length - 1] >= 0xD800 && text[length - 1] <= 0xDBFF)
+            --length;
+        std::copy(ELLIPSIS.begin(), ELLIPSIS.end(), text.begin() + length);
+        return length + ELLIPSIS.size();
+    }
+
+    /**
+     * @brief Writes the file as UTF-8, the default "C" locale fails the stream on any character outside of ASCII.
+     * Must be called before the file is opened.
+    */
+    void ImbueUtf8(std::wofstream& stream) noexcept
+    {
+        for (const char* name : { ".UTF-8", "C.UTF-8", "en_US.UTF-8" })
+        {
+            try
+            {
+                stream.imbue(std::locale(name));
+                return;
+            }
+            catch (const std::exception&)
+            {
+                // Not available on this system, try the next name
+            }
+        }
+    }
+}
+
 LS::Log::LSLogger::LSLogger() : m_stream{ nullptr }
 {
+    try
+    {
+        m_zone = std::chrono::current_zone();
+    }
+    catch (const std::exception&)
+    {
+        // No time zone database, log in UTC
+        m_zone = nullptr;
+    }
 }
 
 LS::Log::LSLogger::~LSLogger()
@@ -150,44 +354,93 @@ LS::Log::LSLogger::~LSLogger()
 
 void LS::Log::LSLogger::Print(std::wstring_view msg) noexcept
 {
-    Print(m_logLevel, msg);
+    Submit(m_logLevel, msg, false);
 }
 
-void LS::Log::LSLogger::Print([[maybe_unused]] std::string_view msg) noexcept
+void LS::Log::LSLogger::Print(std::string_view msg) noexcept
 {
+    Submit(m_logLevel, msg, false);
 }
 
 void LS::Log::LSLogger::Print(LOG_LEVEL level, std::wstring_view msg) noexcept
 {
-    const auto time = std::chrono::system_clock::now();
-    const auto fmtTime = std::chrono::current_zone()->to_local(time);
-    const auto fmt = std::format(L"{} : [{}] || {}", fmtTime, ErrorAsWChar(level), msg);
-    m_stream << fmt;
+    Submit(level, msg, false);
 }
 
-void LS::Log::LSLogger::Print([[maybe_unused]] LOG_LEVEL level, [[maybe_unused]] std::string_view msg) noexcept
+void LS::Log::LSLogger::Print(LOG_LEVEL level, std::string_view msg) noexcept
 {
+    Submit(level, msg, false);
 }
 
 void LS::Log::LSLogger::PrintLine(std::wstring_view msg) noexcept
 {
-    PrintLine(m_logLevel, msg);
+    Submit(m_logLevel, msg, true);
 }
 
-void LS::Log::LSLogger::PrintLine([[maybe_unused]] std::string_view msg) noexcept
+void LS::Log::LSLogger::PrintLine(std::string_view msg) noexcept
 {
+    Submit(m_logLevel, msg, true);
 }
 
 void LS::Log::LSLogger::PrintLine(LOG_LEVEL level, std::wstring_view msg) noexcept
 {
-    const auto time = std::chrono::system_clock::now();
-    const auto fmtTime = std::chrono::current_zone()->to_local(time);
-    const auto fmt = std::format(L"{} : [{}] || {}\n", fmtTime, ErrorAsWChar(level), msg);
-    m_stream << fmt;
+    Submit(level, msg, true);
+}
+
+void LS::Log::LSLogger::PrintLine(LOG_LEVEL level, std::string_view msg) noexcept
+{
+    Submit(level, msg, true);
+}
+
+void LS::Log::LSLogger::Submit(LOG_LEVEL level, std::wstring_view msg, bool isNewLine) noexcept
+{
+    try
+    {
+        std::wstring text;
+        Format(text, level, std::chrono::system_clock::now(), msg, isNewLine);
+        Write(text);
+    }
+    catch (const std::exception&)
+    {
+        // Logging must never take down the caller
+    }
+}
+
+void LS::Log::LSLogger::Submit(LOG_LEVEL level, std::string_view msg, bool isNewLine) noexcept
+{
+    try
+    {
+        const auto wide = LS::Utils::WidenUtf8(msg);
+        Submit(level, std::wstring_view{ wide }, isNewLine);
+    }
+    catch (const std::exception&)
+    {
+    }
+}
+
+void LS::Log::LSLogger::Format(std::wstring& out, LOG_LEVEL level, TimePoint time, std::wstring_view msg, bool isNewLine) const
+{
+    const auto fmtLevel = ErrorAsWChar(level);
+    if (m_zone)
+    {
+        std::format_to(std::back_inserter(out), L"{} : [{}] || {}", m_zone->to_local(time), fmtLevel, msg);
+    }
+    else
+    {
+        std::format_to(std::back_inserter(out), L"{} : [{}] || {}", time, fmtLevel, msg);
+    }
+
+    if (isNewLine)
+        out.push_back(L'\n');
 }
 
-void LS::Log::LSLogger::PrintLine([[maybe_unused]] LOG_LEVEL level, [[maybe_unused]] std::string_view msg) noexcept
+void LS::Log::LSLogger::Write(std::wstring_view text) noexcept
 {
+    std::scoped_lock lock(m_streamLock);
+    m_stream << text;
+    // A character the stream cannot encode must not silence every message after it
+    if (!m_stream)
+        m_stream.clear();
 }
 
 void LS::Log::LSLogger::SetLogLevel(LOG_LEVEL level) noexcept
@@ -202,11 +455,22 @@ auto LS::Log::LSLogger::GetLogLevel() noexcept -> LOG_LEVEL
 
 void LS::Log::LSLogger::Flush() noexcept
 {
+    std::scoped_lock lock(m_streamLock);
     if (!m_stream)
         return;
     m_stream.flush();
 }
 
+auto LS::Log::LSLogger::GetDroppedCount() const noexcept -> uint64_t
+{
+    return 0;
+}
+
+auto LS::Log::LSLogger::GetTruncatedCount() const noexcept -> uint64_t
+{
+    return 0;
+}
+
 void LS::Log::TraceError([[maybe_unused]] std::wstring_view msg)
 {
     using enum LOG_LEVEL;
@@ -285,19 +549,63 @@ auto LS::Log::InitLog(std::filesystem::path filepath, LOG_LEVEL level /*= LOG_LE
     return Logger->Init();
 }
 
+auto LS::Log::InitAsyncLog(AsyncLogSettings settings /*= {}*/, LOG_LEVEL level /*= LOG_LEVEL::DEBUG*/) noexcept -> LS::System::ErrorCode
+{
+    try
+    {
+        Logger = std::make_unique<AsyncLogger>(settings);
+    }
+    catch (const std::exception& e)
+    {
+        return LS::System::CreateFailCode(e.what(), LS::ENGINE_CODE::IO_FAIL);
+    }
+    Logger->SetLogLevel(level);
+    return Logger->Init();
+}
+
+auto LS::Log::InitAsyncLog(std::filesystem::path filepath, AsyncLogSettings settings /*= {}*/, 
+    LOG_LEVEL level /*= LOG_LEVEL::DEBUG*/) noexcept -> LS::System::ErrorCode
+{
+    try
+    {
+        Logger = std::make_unique<AsyncLogger>(filepath, settings);
+    }
+    catch (const std::exception& e)
+    {
+        return LS::System::CreateFailCode(e.what(), LS::ENGINE_CODE::IO_FAIL);
+    }
+    Logger->SetLogLevel(level);
+    return Logger->Init();
+}
+
 void LS::Log::Flush() noexcept
 {
     LOGGER_CHECK;
     Logger->Flush();
 }
 
+auto LS::Log::GetDroppedCount() noexcept -> uint64_t
+{
+    if (!Logger)
+        return 0;
+    return Logger->GetDroppedCount();
+}
+
+auto LS::Log::GetTruncatedCount() noexcept -> uint64_t
+{
+    if (!Logger)
+        return 0;
+    return Logger->GetTruncatedCount();
+}
+
 LS::Log::FileLogger::FileLogger(std::filesystem::path file)
 {
-    if (!std::filesystem::exists(file.relative_path()))
+    if (file.has_parent_path() && !std::filesystem::exists(file.parent_path()))
     {
-        std::filesystem::create_directories(file.relative_path());
+        std::filesystem::create_directories(file.parent_path());
     }
 
+    ImbueUtf8(m_fileStream);
     m_fileStream.open(file, std::ios::out | std::ios::binary);
     if (!m_fileStream.is_open())
     {
@@ -327,4 +635,232 @@ auto LS::Log::ConsoleLogger::Init() noexcept -> LS::System::ErrorCode
         return LS::System::CreateFailCode("The stream is not initialized!", LS::ENGINE_CODE::IO_FAIL);
     }
     return LS::System::CreateSuccessCode();
-}
\ No newline at end of file
+}
+
+LS::Log::AsyncLogger::AsyncLogger(AsyncLogSettings settings) : m_overflow(settings.Overflow)
+{
+    m_stream.rdbuf(std::wcout.rdbuf());
+    Start(settings.Capacity);
+}
+
+LS::Log::AsyncLogger::AsyncLogger(std::filesystem::path file, AsyncLogSettings settings) : m_overflow(settings.Overflow)
+{
+    if (file.has_parent_path() && !std::filesystem::exists(file.parent_path()))
+    {
+        std::filesystem::create_directories(file.parent_path());
+    }
+
+    ImbueUtf8(m_fileStream);
+    m_fileStream.open(file, std::ios::out | std::ios::binary);
+    if (!m_fileStream.is_open())
+    {
+        throw std::runtime_error("Failed to open file for logger.");
+    }
+
+    m_stream.rdbuf(m_fileStream.rdbuf());
+    Start(settings.Capacity);
+}
+
+void LS::Log::AsyncLogger::Start(size_t capacity)
+{
+    capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+    m_records = std::make_unique<Record[]>(capacity);
+    m_mask = capacity - 1;
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        m_records[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+    m_writer = std::thread(&AsyncLogger::Run, this);
+}
+
+LS::Log::AsyncLogger::~AsyncLogger()
+{
+    m_running.store(false);
+    WakeWriter();
+    if (m_writer.joinable())
+        m_writer.join();
+}
+
+auto LS::Log::AsyncLogger::Init() noexcept -> LS::System::ErrorCode
+{
+    if (!m_stream || !m_writer.joinable())
+    {
+        return LS::System::CreateFailCode("The stream is not initialized!", LS::ENGINE_CODE::IO_FAIL);
+    }
+    return LS::System::CreateSuccessCode();
+}
+
+void LS::Log::AsyncLogger::Flush() noexcept
+{
+    const auto target = m_enqueuePos.load(std::memory_order_acquire);
+    while (m_dequeuePos.load(std::memory_order_acquire) < target && m_running.load(std::memory_order_relaxed))
+    {
+        WakeWriter();
+        std::this_thread::yield();
+    }
+    LSLogger::Flush();
+}
+
+auto LS::Log::AsyncLogger::GetDroppedCount() const noexcept -> uint64_t
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+auto LS::Log::AsyncLogger::GetTruncatedCount() const noexcept -> uint64_t
+{
+    return m_truncated.load(std::memory_order_relaxed);
+}
+
+void LS::Log::AsyncLogger::Submit(LOG_LEVEL level, std::wstring_view msg, bool isNewLine) noexcept
+{
+    Enqueue(level, msg, isNewLine);
+}
+
+void LS::Log::AsyncLogger::Submit(LOG_LEVEL level, std::string_view msg, bool isNewLine) noexcept
+{
+    Enqueue(level, msg, isNewLine);
+}
+
+template<class TChar>
+void LS::Log::AsyncLogger::Enqueue(LOG_LEVEL level, std::basic_string_view<TChar> msg, bool isNewLine) noexcept
+{
+    const auto ticks = std::chrono::system_clock::now().time_since_epoch().count();
+
+    // Bounded MPMC queue (D. Vyukov): a slot is free for position pos when its sequence equals pos and 
+    // holds a readable record when it equals pos + 1.
+    auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Record* record = nullptr;
+    for (;;)
+    {
+        Record& slot = m_records[pos & m_mask];
+        const auto seq = slot.Sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                record = &slot;
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full, the writer has not released this slot from the previous lap yet
+            if (m_overflow == LOG_OVERFLOW::DROP || !m_running.load(std::memory_order_relaxed))
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            WakeWriter();
+            std::this_thread::yield();
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t length = 0;
+    bool isTruncated = false;
+    if constexpr (std::is_same_v<TChar, char>)
+    {
+        const auto widened = LS::Utils::WidenUtf8(msg, record->Text);
+        length = widened.Written;
+        isTruncated = widened.Read < msg.size();
+    }
+    else
+    {
+        length = std::min(msg.size(), MAX_MESSAGE_LENGTH);
+        std::copy_n(msg.data(), length, record->Text.data());
+        isTruncated = length < msg.size();
+    }
+
+    if (isTruncated)
+    {
+        length = MarkTruncated(record->Text, length);
+        m_truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    record->Ticks = ticks;
+    record->Level = level;
+    record->IsNewLine = isNewLine;
+    record->Length = static_cast<uint16_t>(length);
+    record->Sequence.store(pos + 1, std::memory_order_release);
+
+    m_signal.fetch_add(1);
+    if (m_writerWaiting.load())
+        m_signal.notify_one();
+}
+
+void LS::Log::AsyncLogger::WakeWriter() noexcept
+{
+    m_signal.fetch_add(1);
+    m_signal.notify_one();
+}
+
+auto LS::Log::AsyncLogger::Drain(std::wstring& batch) noexcept -> size_t
+{
+    // Cap a batch at one lap of the ring so a steady stream of producers cannot grow it without bound
+    auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (count <= m_mask)
+    {
+        Record& slot = m_records[pos & m_mask];
+        if (slot.Sequence.load(std::memory_order_acquire) != pos + 1)
+            break;
+
+        try
+        {
+            const auto time = TimePoint{ TimePoint::duration{ slot.Ticks } };
+            Format(batch, slot.Level, time, std::wstring_view{ slot.Text.data(), slot.Length }, slot.IsNewLine);
+        }
+        catch (const std::exception&)
+        {
+            // Skip the record rather than stall the queue
+        }
+
+        slot.Sequence.store(pos + m_mask + 1, std::memory_order_release);
+        ++pos;
+        ++count;
+    }
+    return count;
+}
+
+void LS::Log::AsyncLogger::Run() noexcept
+{
+    std::wstring batch;
+    batch.reserve(64 * 1024);
+    for (;;)
+    {
+        const auto signal = m_signal.load();
+        const auto begin = m_dequeuePos.load(std::memory_order_relaxed);
+        const auto count = Drain(batch);
+        if (count > 0)
+        {
+            {
+                std::scoped_lock lock(m_streamLock);
+                m_stream << batch;
+                m_stream.flush();
+                if (!m_stream)
+                    m_stream.clear();
+            }
+            batch.clear();
+            m_dequeuePos.store(begin + count, std::memory_order_release);
+            continue;
+        }
+
+        if (!m_running.load())
+            break;
+
+        // Announce the wait, then re-check so a producer that published before seeing the flag is not missed
+        m_writerWaiting.store(true);
+        if (m_records[begin & m_mask].Sequence.load(std::memory_order_acquire) == begin + 1 || !m_running.load())
+        {
+            m_writerWaiting.store(false);
+            continue;
+        }
+        m_signal.wait(signal);
+        m_writerWaiting.store(false);
+    }
+}
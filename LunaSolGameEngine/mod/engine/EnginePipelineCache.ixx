@@ -0,0 +1,559 @@
+module;
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+export module Engine.PipelineCache;
+import Engine.LSDevice;
+import Engine.Shader;
+import LSDataLib;
+import Util.StdUtils;
+
+export namespace LS
+{
+    /**
+     * @brief A resource binding slot paired with its sampler, as stored in PipelineDescriptor::Samplers
+     */
+    using SamplerSet = std::vector<SamplerMap>;
+
+    auto HashState(const LSShaderInputSignature& signature) noexcept -> uint64_t;
+    auto HashState(std::span<const SamplerMap> samplers) noexcept -> uint64_t;
+
+    /**
+     * @brief Hash of the shader stages and their byte code. Independent of the map's iteration order.
+     */
+    auto HashShaders(const ShaderPipeline& shaders) noexcept -> uint64_t;
+
+    /**
+     * @brief 64-bit key of a full pipeline: the canonical rasterizer, blend and depth-stencil states, the interned
+     * shader set, input signature, topology, render target format and samplers. Textures and buffers are per draw
+     * bindings and are not part of the key. Shader byte code is hashed once when it is interned, not here.
+     */
+    auto HashPipeline(const PipelineDescriptor& pipeline, StateHandle shaders) noexcept -> uint64_t;
+
+    /**
+     * @brief The identity of an interned pipeline, in terms of its interned sub-states
+     */
+    struct PipelineStateKey
+    {
+        StateHandle Rasterizer = INVALID_STATE_HANDLE;
+        StateHandle Blend = INVALID_STATE_HANDLE;
+        StateHandle DepthStencil = INVALID_STATE_HANDLE;
+        StateHandle InputLayout = INVALID_STATE_HANDLE;
+        StateHandle Samplers = INVALID_STATE_HANDLE;
+        StateHandle Shaders = INVALID_STATE_HANDLE;
+        PRIMITIVE_TOPOLOGY Topology = PRIMITIVE_TOPOLOGY::TRIANGLE_LIST;
+        PIXEL_COLOR_FORMAT RenderTargetFormat = PIXEL_COLOR_FORMAT::UNKNOWN;
+        uint32_t SampleCount = 0u;
+        uint32_t SampleQuality = 0u;
+        uint64_t Key = 0u;//@brief HashPipeline of the descriptor and Shaders
+
+        bool operator==(const PipelineStateKey&) const = default;
+    };
+
+    struct CacheCounters
+    {
+        uint64_t Lookups = 0u;
+        uint64_t Hits = 0u;
+        uint64_t Misses = 0u;
+        uint64_t TotalLookupNs = 0u;
+
+        [[nodiscard]] auto HitRate() const noexcept -> double
+        {
+            return Lookups > 0u ? static_cast<double>(Hits) / static_cast<double>(Lookups) : 0.0;
+        }
+
+        [[nodiscard]] auto AverageLookupNs() const noexcept -> double
+        {
+            return Lookups > 0u ? static_cast<double>(TotalLookupNs) / static_cast<double>(Lookups) : 0.0;
+        }
+    };
+
+    struct PipelineCacheStats
+    {
+        CacheCounters Pipelines; //@brief Intern(PipelineDescriptor) calls, latency includes hashing the descriptor
+        CacheCounters SubStates; //@brief Sub-state interning, direct or on a pipeline miss (no latency recorded)
+        uint32_t RasterizerCount = 0u;
+        uint32_t BlendCount = 0u;
+        uint32_t DepthStencilCount = 0u;
+        uint32_t InputLayoutCount = 0u;
+        uint32_t SamplerSetCount = 0u;
+        uint32_t ShaderSetCount = 0u;
+        uint32_t PipelineCount = 0u;
+    };
+
+    /**
+     * @brief A thread-safe set of unique T, each named by the StateHandle it was first interned with.
+     * Handles are assigned in insertion order starting at 0 and stay valid for the lifetime of the table.
+     */
+    template<class T>
+    class StateTable
+    {
+    public:
+        /**
+         * @brief Finds or inserts @p state (which should already be canonical) under @p key
+         * @return The handle and whether it was already present
+         */
+        auto Intern(const T& state, uint64_t key) -> std::pair<StateHandle, bool>
+        {
+            {
+                std::shared_lock lock(m_lock);
+                if (const auto handle = Find(state, key); handle != INVALID_STATE_HANDLE)
+                    return { handle, true };
+            }
+
+            std::unique_lock lock(m_lock);
+            if (const auto handle = Find(state, key); handle != INVALID_STATE_HANDLE)
+                return { handle, true };
+
+            // Distinct states that share a key are chained by re-mixing the key
+            auto slot = key;
+            while (m_lookup.contains(slot))
+            {
+                slot = LS::Utils::Mix64(slot + 1u);
+            }
+
+            const auto handle = static_cast<StateHandle>(m_states.size());
+            m_states.push_back(state);
+            m_keys.push_back(key);
+            m_lookup.emplace(slot, handle);
+            return { handle, false };
+        }
+
+        /**
+         * @brief The state for a handle returned by Intern. The reference stays valid while the table is alive.
+         */
+        [[nodiscard]] auto Get(StateHandle handle) const -> const T&
+        {
+            std::shared_lock lock(m_lock);
+            return m_states[handle];
+        }
+
+        [[nodiscard]] auto GetKey(StateHandle handle) const -> uint64_t
+        {
+            std::shared_lock lock(m_lock);
+            return m_keys[handle];
+        }
+
+        [[nodiscard]] auto Size() const -> uint32_t
+        {
+            std::shared_lock lock(m_lock);
+            return static_cast<uint32_t>(m_states.size());
+        }
+
+    private:
+        struct KeyHash
+        {
+            // Keys are already well mixed
+            auto operator()(uint64_t key) const noexcept -> size_t
+            {
+                return static_cast<size_t>(key);
+            }
+        };
+
+        auto Find(const T& state, uint64_t key) const -> StateHandle
+        {
+            auto slot = key;
+            for (auto it = m_lookup.find(slot); it != m_lookup.end(); it = m_lookup.find(slot))
+            {
+                if (m_keys[it->second] == key && m_states[it->second] == state)
+                    return it->second;
+                slot = LS::Utils::Mix64(slot + 1u);
+            }
+            return INVALID_STATE_HANDLE;
+        }
+
+        mutable std::shared_mutex m_lock;
+        std::unordered_map<uint64_t, StateHandle, KeyHash> m_lookup;
+        std::deque<T> m_states;
+        std::vector<uint64_t> m_keys;
+    };
+
+    /**
+     * @brief Interns pipeline descriptors and their sub-states into small integer handles so that backends create
+     * each native state object once per handle instead of comparing descriptors.
+     *
+     * Sub-states are canonicalized before hashing, so equivalent states (e.g. two depth-disabled states with
+     * different depth functions) share a handle, and are compared exactly on lookup. Pipelines are found by their
+     * 64-bit HashPipeline key and then compared field by field, so a key collision never returns the wrong pipeline.
+     *
+     * Shader blobs are the only large part of a descriptor. Intern them once with InternShaders when the shaders
+     * are created and store the handle in PipelineDescriptor::ShaderSet, so lookups hash and compare fixed-size
+     * fields only. The handle must come from this cache. Descriptors without a ShaderSet still work, but pay for
+     * hashing the blobs on every call.
+     */
+    class PipelineCache
+    {
+    public:
+        PipelineCache() = default;
+        ~PipelineCache() = default;
+
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        [[nodiscard]] auto Intern(const PipelineDescriptor& pipeline) -> StateHandle;
+
+        [[nodiscard]] auto InternRasterizer(const RasterizerInfo& state) -> StateHandle;
+        [[nodiscard]] auto InternBlend(const LSBlendState& state) -> StateHandle;
+        [[nodiscard]] auto InternDepthStencil(const DepthStencil& state) -> StateHandle;
+        [[nodiscard]] auto InternInputLayout(const LSShaderInputSignature& signature) -> StateHandle;
+        [[nodiscard]] auto InternSamplers(std::span<const SamplerMap> samplers) -> StateHandle;
+        [[nodiscard]] auto InternShaders(const ShaderPipeline& shaders) -> StateHandle;
+
+        [[nodiscard]] auto GetPipeline(StateHandle handle) const -> const PipelineStateKey&;
+        [[nodiscard]] auto GetRasterizer(StateHandle handle) const -> const RasterizerInfo&;
+        [[nodiscard]] auto GetBlend(StateHandle handle) const -> const LSBlendState&;
+        [[nodiscard]] auto GetDepthStencil(StateHandle handle) const -> const DepthStencil&;
+        [[nodiscard]] auto GetInputLayout(StateHandle handle) const -> const LSShaderInputSignature&;
+        [[nodiscard]] auto GetSamplers(StateHandle handle) const -> const SamplerSet&;
+        [[nodiscard]] auto GetShaders(StateHandle handle) const -> const ShaderPipeline&;
+
+        [[nodiscard]] auto GetStats() const -> PipelineCacheStats;
+        void ResetStats() noexcept;
+
+    private:
+        struct AtomicCounters
+        {
+            std::atomic<uint64_t> Lookups = 0u;
+            std::atomic<uint64_t> Hits = 0u;
+            std::atomic<uint64_t> TotalLookupNs = 0u;
+
+            void Reset() noexcept
+            {
+                Lookups.store(0u, std::memory_order_relaxed);
+                Hits.store(0u, std::memory_order_relaxed);
+                TotalLookupNs.store(0u, std::memory_order_relaxed);
+            }
+
+            auto Load() const noexcept -> CacheCounters
+            {
+                CacheCounters out;
+                out.Lookups = Lookups.load(std::memory_order_relaxed);
+                out.Hits = Hits.load(std::memory_order_relaxed);
+                out.Misses = out.Lookups - std::min(out.Hits, out.Lookups);
+                out.TotalLookupNs = TotalLookupNs.load(std::memory_order_relaxed);
+                return out;
+            }
+        };
+
+        /**
+         * @brief The canonical keyed fields of an interned descriptor, compared against the descriptor on a fast path hit
+         */
+        struct PipelineEntry
+        {
+            StateHandle Handle = INVALID_STATE_HANDLE;
+            RasterizerInfo Rasterizer;
+            LSBlendState Blend;
+            DepthStencil DepthStencil;
+            const LSShaderInputSignature* InputLayout = nullptr;
+            const SamplerSet* Samplers = nullptr;
+            StateHandle Shaders = INVALID_STATE_HANDLE;
+            PRIMITIVE_TOPOLOGY Topology = PRIMITIVE_TOPOLOGY::TRIANGLE_LIST;
+            PIXEL_COLOR_FORMAT RenderTargetFormat = PIXEL_COLOR_FORMAT::UNKNOWN;
+            uint32_t SampleCount = 0u;
+            uint32_t SampleQuality = 0u;
+
+            [[nodiscard]] auto Matches(const PipelineDescriptor& pipeline, StateHandle shaders) const -> bool;
+        };
+
+        auto FindPipeline(const PipelineDescriptor& pipeline, StateHandle shaders, uint64_t key) const -> StateHandle;
+        auto Count(std::pair<StateHandle, bool> result) noexcept -> StateHandle;
+
+        StateTable<RasterizerInfo> m_rasterizers;
+        StateTable<LSBlendState> m_blends;
+        StateTable<DepthStencil> m_depthStencils;
+        StateTable<LSShaderInputSignature> m_inputLayouts;
+        StateTable<SamplerSet> m_samplers;
+        StateTable<ShaderPipeline> m_shaders;
+        StateTable<PipelineStateKey> m_pipelines;
+
+        // Full descriptor key to pipeline, the fast path for repeated lookups. Entries point into the sub-state
+        // tables, which keep their elements at a stable address for the lifetime of the cache.
+        mutable std::shared_mutex m_pipelineLock;
+        std::unordered_multimap<uint64_t, PipelineEntry> m_pipelineLookup;
+
+        alignas(64) AtomicCounters m_pipelineCounters;
+        alignas(64) AtomicCounters m_subStateCounters;
+    };
+}
+
+module : private;
+
+namespace
+{
+    auto ToBytes(std::string_view text) noexcept -> std::span<const std::byte>
+    {
+        return { reinterpret_cast<const std::byte*>(text.data()), text.size() };
+    }
+}
+
+namespace LS
+{
+    auto HashState(const LSShaderInputSignature& signature) noexcept -> uint64_t
+    {
+        auto hash = LS::Utils::HashCombine(0x494E'5055'5453'0001ull, signature.Elements.size());
+        for (const auto& element : signature.Elements)
+        {
+            hash = LS::Utils::HashCombine(hash, LS::Utils::HashBytes(ToBytes(element.SemanticName)));
+            hash = LS::Utils::HashCombine(hash, static_cast<uint64_t>(element.ShaderData)
+                | static_cast<uint64_t>(element.InputClass) << 32);
+            hash = LS::Utils::HashCombine(hash, static_cast<uint64_t>(element.SemanticIndex)
+                | static_cast<uint64_t>(element.OffsetAligned) << 32);
+            hash = LS::Utils::HashCombine(hash, static_cast<uint64_t>(element.InputSlot)
+                | static_cast<uint64_t>(element.InstanceStepRate) << 32);
+        }
+        return hash;
+    }
+
+    auto HashState(std::span<const SamplerMap> samplers) noexcept -> uint64_t
+    {
+        auto hash = LS::Utils::HashCombine(0x5341'4D50'5345'0001ull, samplers.size());
+        for (const auto& sampler : samplers)
+        {
+            hash = LS::Utils::HashCombine(hash, sampler.BindSlot);
+            hash = LS::Utils::HashCombine(hash, HashState(sampler.Sampler));
+        }
+        return hash;
+    }
+
+    auto HashShaders(const ShaderPipeline& shaders) noexcept -> uint64_t
+    {
+        // unordered_map order is unspecified, so sum the mixed per-stage hashes
+        uint64_t sum = 0u;
+        for (const auto& [stage, code] : shaders)
+        {
+            sum += LS::Utils::HashCombine(static_cast<uint64_t>(stage), LS::Utils::HashBytes(code));
+        }
+        return LS::Utils::HashCombine(0x5348'4144'4552'0001ull ^ shaders.size(), sum);
+    }
+
+    auto HashPipeline(const PipelineDescriptor& pipeline, StateHandle shaders) noexcept -> uint64_t
+    {
+        auto hash = HashState(Canonicalize(pipeline.RasterizeState));
+        hash = LS::Utils::HashCombine(hash, HashState(Canonicalize(pipeline.BlendState)));
+        hash = LS::Utils::HashCombine(hash, HashState(Canonicalize(pipeline.DepthStencil)));
+        hash = LS::Utils::HashCombine(hash, shaders);
+        hash = LS::Utils::HashCombine(hash, HashState(pipeline.ShaderSignature));
+        hash = LS::Utils::HashCombine(hash, HashState(std::span<const SamplerMap>{ pipeline.Samplers }));
+        hash = LS::Utils::HashCombine(hash, static_cast<uint64_t>(pipeline.Topology)
+            | static_cast<uint64_t>(pipeline.RenderTarget.PixelFormat) << 32);
+        return LS::Utils::HashCombine(hash, static_cast<uint64_t>(pipeline.RenderTarget.SampleCount)
+            | static_cast<uint64_t>(pipeline.RenderTarget.SampleQuality) << 32);
+    }
+
+    auto PipelineCache::Intern(const PipelineDescriptor& pipeline) -> StateHandle
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        // Without a valid ShaderSet the blobs are hashed here, which is most of the cost of a hit
+        auto shaders = std::pair{ pipeline.ShaderSet, true };
+        const auto hasShaderSet = shaders.first < m_shaders.Size();
+        if (!hasShaderSet)
+        {
+            shaders = m_shaders.Intern(pipeline.Shaders, HashShaders(pipeline.Shaders));
+        }
+        const auto key = HashPipeline(pipeline, shaders.first);
+
+        auto handle = INVALID_STATE_HANDLE;
+        {
+            std::shared_lock lock(m_pipelineLock);
+            handle = FindPipeline(pipeline, shaders.first, key);
+        }
+
+        const auto isHit = handle != INVALID_STATE_HANDLE;
+        if (!isHit)
+        {
+            const PipelineStateKey state{
+                .Rasterizer = InternRasterizer(pipeline.RasterizeState),
+                .Blend = InternBlend(pipeline.BlendState),
+                .DepthStencil = InternDepthStencil(pipeline.DepthStencil),
+                .InputLayout = InternInputLayout(pipeline.ShaderSignature),
+                .Samplers = InternSamplers(pipeline.Samplers),
+                .Shaders = hasShaderSet ? shaders.first : Count(shaders),
+                .Topology = pipeline.Topology,
+                .RenderTargetFormat = pipeline.RenderTarget.PixelFormat,
+                .SampleCount = pipeline.RenderTarget.SampleCount,
+                .SampleQuality = pipeline.RenderTarget.SampleQuality,
+                .Key = key,
+            };
+            handle = m_pipelines.Intern(state, key).first;
+
+            std::unique_lock lock(m_pipelineLock);
+            if (FindPipeline(pipeline, state.Shaders, key) == INVALID_STATE_HANDLE)
+            {
+                m_pipelineLookup.emplace(key, PipelineEntry{
+                    .Handle = handle,
+                    .Rasterizer = m_rasterizers.Get(state.Rasterizer),
+                    .Blend = m_blends.Get(state.Blend),
+                    .DepthStencil = m_depthStencils.Get(state.DepthStencil),
+                    .InputLayout = &m_inputLayouts.Get(state.InputLayout),
+                    .Samplers = &m_samplers.Get(state.Samplers),
+                    .Shaders = state.Shaders,
+                    .Topology = state.Topology,
+                    .RenderTargetFormat = state.RenderTargetFormat,
+                    .SampleCount = state.SampleCount,
+                    .SampleQuality = state.SampleQuality,
+                    });
+            }
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        m_pipelineCounters.Lookups.fetch_add(1u, std::memory_order_relaxed);
+        m_pipelineCounters.TotalLookupNs.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        if (isHit)
+        {
+            m_pipelineCounters.Hits.fetch_add(1u, std::memory_order_relaxed);
+        }
+        return handle;
+    }
+
+    auto PipelineCache::InternRasterizer(const RasterizerInfo& state) -> StateHandle
+    {
+        const auto canonical = Canonicalize(state);
+        return Count(m_rasterizers.Intern(canonical, HashState(canonical)));
+    }
+
+    auto PipelineCache::InternBlend(const LSBlendState& state) -> StateHandle
+    {
+        const auto canonical = Canonicalize(state);
+        return Count(m_blends.Intern(canonical, HashState(canonical)));
+    }
+
+    auto PipelineCache::InternDepthStencil(const DepthStencil& state) -> StateHandle
+    {
+        const auto canonical = Canonicalize(state);
+        return Count(m_depthStencils.Intern(canonical, HashState(canonical)));
+    }
+
+    auto PipelineCache::InternInputLayout(const LSShaderInputSignature& signature) -> StateHandle
+    {
+        return Count(m_inputLayouts.Intern(signature, HashState(signature)));
+    }
+
+    auto PipelineCache::InternSamplers(std::span<const SamplerMap> samplers) -> StateHandle
+    {
+        SamplerSet canonical;
+        canonical.reserve(samplers.size());
+        for (const auto& sampler : samplers)
+        {
+            canonical.push_back(SamplerMap{ .BindSlot = sampler.BindSlot, .Sampler = Canonicalize(sampler.Sampler) });
+        }
+        return Count(m_samplers.Intern(canonical, HashState(std::span<const SamplerMap>{ canonical })));
+    }
+
+    auto PipelineCache::InternShaders(const ShaderPipeline& shaders) -> StateHandle
+    {
+        return Count(m_shaders.Intern(shaders, HashShaders(shaders)));
+    }
+
+    auto PipelineCache::GetPipeline(StateHandle handle) const -> const PipelineStateKey&
+    {
+        return m_pipelines.Get(handle);
+    }
+
+    auto PipelineCache::GetRasterizer(StateHandle handle) const -> const RasterizerInfo&
+    {
+        return m_rasterizers.Get(handle);
+    }
+
+    auto PipelineCache::GetBlend(StateHandle handle) const -> const LSBlendState&
+    {
+        return m_blends.Get(handle);
+    }
+
+    auto PipelineCache::GetDepthStencil(StateHandle handle) const -> const DepthStencil&
+    {
+        return m_depthStencils.Get(handle);
+    }
+
+    auto PipelineCache::GetInputLayout(StateHandle handle) const -> const LSShaderInputSignature&
+    {
+        return m_inputLayouts.Get(handle);
+    }
+
+    auto PipelineCache::GetSamplers(StateHandle handle) const -> const SamplerSet&
+    {
+        return m_samplers.Get(handle);
+    }
+
+    auto PipelineCache::GetShaders(StateHandle handle) const -> const ShaderPipeline&
+    {
+        return m_shaders.Get(handle);
+    }
+
+    auto PipelineCache::GetStats() const -> PipelineCacheStats
+    {
+        PipelineCacheStats stats;
+        stats.Pipelines = m_pipelineCounters.Load();
+        stats.SubStates = m_subStateCounters.Load();
+        stats.RasterizerCount = m_rasterizers.Size();
+        stats.BlendCount = m_blends.Size();
+        stats.DepthStencilCount = m_depthStencils.Size();
+        stats.InputLayoutCount = m_inputLayouts.Size();
+        stats.SamplerSetCount = m_samplers.Size();
+        stats.ShaderSetCount = m_shaders.Size();
+        stats.PipelineCount = m_pipelines.Size();
+        return stats;
+    }
+
+    void PipelineCache::ResetStats() noexcept
+    {
+        m_pipelineCounters.Reset();
+        m_subStateCounters.Reset();
+    }
+
+    auto PipelineCache::PipelineEntry::Matches(const PipelineDescriptor& pipeline, StateHandle shaders) const -> bool
+    {
+        if (Shaders != shaders
+            || Topology != pipeline.Topology
+            || RenderTargetFormat != pipeline.RenderTarget.PixelFormat
+            || SampleCount != pipeline.RenderTarget.SampleCount
+            || SampleQuality != pipeline.RenderTarget.SampleQuality
+            || Samplers->size() != pipeline.Samplers.size())
+        {
+            return false;
+        }
+
+        for (auto i = 0u; i < pipeline.Samplers.size(); ++i)
+        {
+            const auto& sampler = pipeline.Samplers[i];
+            if ((*Samplers)[i].BindSlot != sampler.BindSlot || (*Samplers)[i].Sampler != Canonicalize(sampler.Sampler))
+                return false;
+        }
+
+        return Rasterizer == Canonicalize(pipeline.RasterizeState)
+            && Blend == Canonicalize(pipeline.BlendState)
+            && DepthStencil == Canonicalize(pipeline.DepthStencil)
+            && *InputLayout == pipeline.ShaderSignature;
+    }
+
+    auto PipelineCache::FindPipeline(const PipelineDescriptor& pipeline, StateHandle shaders, uint64_t key) const -> StateHandle
+    {
+        const auto [first, last] = m_pipelineLookup.equal_range(key);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second.Matches(pipeline, shaders))
+                return it->second.Handle;
+        }
+        return INVALID_STATE_HANDLE;
+    }
+
+    auto PipelineCache::Count(std::pair<StateHandle, bool> result) noexcept -> StateHandle
+    {
+        m_subStateCounters.Lookups.fetch_add(1u, std::memory_order_relaxed);
+        if (result.second)
+        {
+            m_subStateCounters.Hits.fetch_add(1u, std::memory_order_relaxed);
+        }
+        return result.first;
+    }
+}
@@ -0,0 +1,583 @@
+module;
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+export module Engine.Profiler;
+import Clock;
+import Engine.EngineCodes;
+
+export namespace LS::Profile
+{
+    enum class EVENT_TYPE : uint8_t
+    {
+        ZONE = 0,//@brief A timed scope, Start to End
+        COUNTER, //@brief A named value sampled at Start
+        FRAME, //@brief A frame boundary, Value holds the frame number
+    };
+
+    /**
+     * @brief A single entry of a thread's event ring. Names must be string literals (or otherwise outlive the profiler).
+     */
+    struct ProfileEvent
+    {
+        const char* Name = nullptr;
+        uint64_t Start = 0;//@brief Nanoseconds since the profiler started
+        uint64_t End = 0;
+        double Value = 0.0;
+        uint16_t Depth = 0;
+        EVENT_TYPE Type = EVENT_TYPE::ZONE;
+    };
+
+    /**
+     * @brief Frame time statistics over the last FRAME_HISTORY frames, in milliseconds
+     */
+    struct FrameSummary
+    {
+        uint32_t FrameCount = 0;
+        double MinMs = 0.0;
+        double AvgMs = 0.0;
+        double P95Ms = 0.0;
+        double P99Ms = 0.0;
+        double MaxMs = 0.0;
+    };
+
+    // Events kept per thread before the oldest are overwritten
+    constexpr size_t THREAD_EVENT_CAPACITY = 1u << 16;
+    // Frames kept for the rolling frame time summary
+    constexpr size_t FRAME_HISTORY = 600u;
+    // Buffers of exited threads kept for the next export, past this the oldest are recycled without being exported
+    constexpr size_t MAX_RETIRED_THREAD_BUFFERS = 8u;
+
+    namespace Detail
+    {
+        inline std::atomic<bool> Enabled = false;
+
+        [[nodiscard]] auto Now() noexcept -> uint64_t;
+        [[nodiscard]] auto BeginZone() noexcept -> uint16_t;
+        void EndZone(const char* name, uint64_t start, uint16_t depth) noexcept;
+    }
+
+    /**
+     * @brief Starts or stops recording zones and counters. Frame times are always collected by MarkFrame.
+     */
+    void SetEnabled(bool enabled) noexcept;
+
+    [[nodiscard]] inline auto IsEnabled() noexcept -> bool
+    {
+        return Detail::Enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Times the enclosing scope. When the profiler is disabled construction is a single relaxed load.
+     */
+    class ScopedZone
+    {
+    public:
+        explicit ScopedZone(const char* name) noexcept : m_name(name)
+        {
+            if (!IsEnabled())
+                return;
+            m_isActive = true;
+            m_depth = Detail::BeginZone();
+            m_start = Detail::Now();
+        }
+
+        ~ScopedZone()
+        {
+            if (m_isActive)
+            {
+                Detail::EndZone(m_name, m_start, m_depth);
+            }
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_start = 0;
+        uint16_t m_depth = 0;
+        bool m_isActive = false;
+    };
+
+    /**
+     * @brief Records a named value, shown as a counter track in the trace
+     */
+    void RecordCounter(const char* name, double value) noexcept;
+
+    /**
+     * @brief Marks the end of a frame. Call once per frame from the thread that drives the frame loop.
+     * The profiler numbers the frames itself, the swap chain's back buffer index repeats every few frames.
+     */
+    void MarkFrame() noexcept;
+
+    /**
+     * @brief Number of frames marked since the process started, not cleared by Reset
+     */
+    [[nodiscard]] auto GetFrameNumber() noexcept -> uint64_t;
+
+    /**
+     * @brief Names the calling thread in exported traces
+     */
+    void SetThreadName(const char* name) noexcept;
+
+    /**
+     * @brief Clears every thread's events and the frame history. Should not race with recording threads.
+     */
+    void Reset() noexcept;
+
+    /**
+     * @brief Number of thread buffers allocated so far. Buffers of exited threads are reused, so this is bounded by
+     * the peak number of recording threads plus MAX_RETIRED_THREAD_BUFFERS.
+     */
+    [[nodiscard]] auto GetThreadBufferCount() noexcept -> size_t;
+
+    [[nodiscard]] auto GetFrameSummary() noexcept -> FrameSummary;
+
+    /**
+     * @brief The frame summary as a single line of text, for logs and headless runs
+     */
+    [[nodiscard]] auto FormatFrameSummary() -> std::string;
+
+    /**
+     * @brief Writes all recorded events as Chrome trace_event JSON (chrome://tracing, Perfetto).
+     * Events overwritten while the export is running are skipped. Events of threads that exited since the last
+     * export are written once, then their buffers are reused.
+     * @param file The file to create or replace
+     */
+    [[nodiscard]] auto ExportChromeTrace(const std::filesystem::path& file) noexcept -> LS::System::ErrorCode;
+}
+
+module : private;
+
+namespace
+{
+    using namespace LS::Profile;
+
+    /**
+     * @brief Single writer (the owning thread) ring of events. Taken the first time a thread records, from the free
+     * list when a previous thread left one behind.
+     */
+    struct ThreadBuffer
+    {
+        std::array<ProfileEvent, THREAD_EVENT_CAPACITY> Events;
+        std::atomic<uint64_t> Head = 0;
+        uint32_t ThreadId = 0;
+        std::string Name;
+    };
+
+    struct ThreadState
+    {
+        ThreadBuffer* Buffer = nullptr;
+        uint16_t Depth = 0;
+    };
+
+    struct FrameHistory
+    {
+        std::mutex Lock;
+        std::array<uint64_t, FRAME_HISTORY> Times{};
+        size_t Count = 0;
+        size_t Next = 0;
+        uint64_t LastMark = 0;
+        uint64_t FrameNumber = 0;
+        bool HasLastMark = false;
+    };
+
+    std::mutex g_registryLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+    // Buffers of exited threads whose events have not been exported yet, oldest first
+    std::vector<ThreadBuffer*> g_retiredBuffers;
+    // Buffers with no owner and no events left to export
+    std::vector<ThreadBuffer*> g_freeBuffers;
+    uint32_t g_nextThreadId = 1u;
+    FrameHistory g_frames;
+    thread_local ThreadState t_state;
+
+    // Callers hold g_registryLock
+    void FreeBuffer(ThreadBuffer* buffer)
+    {
+        buffer->Head.store(0u, std::memory_order_release);
+        buffer->Name.clear();
+        g_freeBuffers.push_back(buffer);
+    }
+
+    void FreeRetiredBuffers()
+    {
+        for (auto* buffer : g_retiredBuffers)
+        {
+            FreeBuffer(buffer);
+        }
+        g_retiredBuffers.clear();
+    }
+
+    /**
+     * @brief Hands the thread's buffer back when the thread exits. A separate thread_local from t_state so zones
+     * keep touching a trivially destructible thread_local.
+     */
+    struct BufferLease
+    {
+        ThreadBuffer* Buffer = nullptr;
+
+        ~BufferLease()
+        {
+            if (!Buffer)
+                return;
+
+            t_state.Buffer = nullptr;
+            try
+            {
+                std::scoped_lock lock(g_registryLock);
+                g_retiredBuffers.push_back(Buffer);
+                if (g_retiredBuffers.size() > MAX_RETIRED_THREAD_BUFFERS)
+                {
+                    FreeBuffer(g_retiredBuffers.front());
+                    g_retiredBuffers.erase(g_retiredBuffers.begin());
+                }
+            }
+            catch (const std::exception&)
+            {
+                // The registry lock failed, the buffer stays allocated but is not reused
+            }
+        }
+    };
+
+    auto ProfilerClock() noexcept -> const LS::Clock&
+    {
+        static const LS::Clock clock = []()
+            {
+                LS::Clock c;
+                c.Start();
+                return c;
+            }();
+        return clock;
+    }
+
+    auto GetThreadBuffer() noexcept -> ThreadBuffer*
+    {
+        if (t_state.Buffer)
+            return t_state.Buffer;
+
+        try
+        {
+            thread_local BufferLease lease;
+            std::scoped_lock lock(g_registryLock);
+            ThreadBuffer* buffer = nullptr;
+            if (!g_freeBuffers.empty())
+            {
+                buffer = g_freeBuffers.back();
+                g_freeBuffers.pop_back();
+            }
+            else
+            {
+                // Every buffer fits on the free list and the retired list never grows past its cap,
+                // so retiring and freeing never allocate
+                g_freeBuffers.reserve(g_buffers.size() + 1u);
+                g_retiredBuffers.reserve(MAX_RETIRED_THREAD_BUFFERS + 1u);
+                buffer = g_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+            }
+
+            // A fresh id per thread, so a reused buffer does not merge two threads' tracks in the trace
+            buffer->ThreadId = g_nextThreadId++;
+            lease.Buffer = buffer;
+            t_state.Buffer = buffer;
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+        return t_state.Buffer;
+    }
+
+    void Push(const ProfileEvent& event) noexcept
+    {
+        auto* buffer = GetThreadBuffer();
+        if (!buffer)
+            return;
+
+        const auto head = buffer->Head.load(std::memory_order_relaxed);
+        buffer->Events[head % THREAD_EVENT_CAPACITY] = event;
+        buffer->Head.store(head + 1u, std::memory_order_release);
+    }
+
+    void AppendEscaped(std::string& out, std::string_view text)
+    {
+        for (const auto c : text)
+        {
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+                else
+                    out.push_back(c);
+                break;
+            }
+        }
+    }
+
+    void AppendEvent(std::string& out, const ProfileEvent& event, uint32_t tid)
+    {
+        // trace_event timestamps are microseconds
+        const auto ts = static_cast<double>(event.Start) / 1000.0;
+        out += "{\"name\":\"";
+        AppendEscaped(out, event.Name ? event.Name : "");
+        out += "\",";
+
+        switch (event.Type)
+        {
+        case EVENT_TYPE::ZONE:
+            std::format_to(std::back_inserter(out), "\"cat\":\"zone\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{\"depth\":{}}}}}",
+                ts, static_cast<double>(event.End - event.Start) / 1000.0, tid, event.Depth);
+            break;
+        case EVENT_TYPE::COUNTER:
+            // JSON has no inf or nan, a non-finite sample is written as null
+            std::format_to(std::back_inserter(out), "\"cat\":\"counter\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{\"value\":",
+                ts, tid);
+            if (std::isfinite(event.Value))
+                std::format_to(std::back_inserter(out), "{}}}}}", event.Value);
+            else
+                out += "null}}";
+            break;
+        case EVENT_TYPE::FRAME:
+            std::format_to(std::back_inserter(out), "\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{\"frame\":{}}}}}",
+                ts, tid, static_cast<uint64_t>(event.Value));
+            break;
+        }
+    }
+}
+
+namespace LS::Profile
+{
+    auto Detail::Now() noexcept -> uint64_t
+    {
+        return ProfilerClock().GetEpochNs();
+    }
+
+    auto Detail::BeginZone() noexcept -> uint16_t
+    {
+        return t_state.Depth++;
+    }
+
+    void Detail::EndZone(const char* name, uint64_t start, uint16_t depth) noexcept
+    {
+        const auto end = Now();
+        t_state.Depth = depth;
+        Push(ProfileEvent{ .Name = name, .Start = start, .End = end, .Depth = depth, .Type = EVENT_TYPE::ZONE });
+    }
+
+    void SetEnabled(bool enabled) noexcept
+    {
+        // Start the clock before the first zone can read it
+        [[maybe_unused]] const auto& clock = ProfilerClock();
+        Detail::Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void RecordCounter(const char* name, double value) noexcept
+    {
+        if (!IsEnabled())
+            return;
+
+        const auto now = Detail::Now();
+        Push(ProfileEvent{ .Name = name, .Start = now, .End = now, .Value = value, .Type = EVENT_TYPE::COUNTER });
+    }
+
+    void MarkFrame() noexcept
+    {
+        const auto now = Detail::Now();
+        uint64_t frameNumber = 0u;
+        {
+            std::scoped_lock lock(g_frames.Lock);
+            frameNumber = g_frames.FrameNumber++;
+            if (g_frames.HasLastMark)
+            {
+                g_frames.Times[g_frames.Next] = now - g_frames.LastMark;
+                g_frames.Next = (g_frames.Next + 1u) % FRAME_HISTORY;
+                g_frames.Count = std::min(g_frames.Count + 1u, FRAME_HISTORY);
+            }
+            g_frames.LastMark = now;
+            g_frames.HasLastMark = true;
+        }
+
+        if (!IsEnabled())
+            return;
+
+        Push(ProfileEvent{ .Name = "Frame", .Start = now, .End = now, .Value = static_cast<double>(frameNumber),
+            .Type = EVENT_TYPE::FRAME });
+    }
+
+    auto GetFrameNumber() noexcept -> uint64_t
+    {
+        std::scoped_lock lock(g_frames.Lock);
+        return g_frames.FrameNumber;
+    }
+
+    void SetThreadName(const char* name) noexcept
+    {
+        auto* buffer = GetThreadBuffer();
+        if (!buffer || !name)
+            return;
+
+        try
+        {
+            std::scoped_lock lock(g_registryLock);
+            buffer->Name = name;
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    void Reset() noexcept
+    {
+        {
+            std::scoped_lock lock(g_registryLock);
+            for (auto& buffer : g_buffers)
+            {
+                buffer->Head.store(0u, std::memory_order_release);
+            }
+            FreeRetiredBuffers();
+        }
+
+        std::scoped_lock lock(g_frames.Lock);
+        g_frames.Count = 0u;
+        g_frames.Next = 0u;
+        g_frames.HasLastMark = false;
+    }
+
+    auto GetThreadBufferCount() noexcept -> size_t
+    {
+        std::scoped_lock lock(g_registryLock);
+        return g_buffers.size();
+    }
+
+    auto GetFrameSummary() noexcept -> FrameSummary
+    {
+        std::array<uint64_t, FRAME_HISTORY> times;
+        size_t count = 0u;
+        {
+            std::scoped_lock lock(g_frames.Lock);
+            count = g_frames.Count;
+            std::copy_n(g_frames.Times.begin(), count, times.begin());
+        }
+
+        FrameSummary summary;
+        if (count == 0u)
+            return summary;
+
+        const auto first = times.begin();
+        const auto last = times.begin() + count;
+        std::sort(first, last);
+
+        // Nearest-rank percentile
+        const auto percentile = [&](double p)
+            {
+                const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(count)));
+                return static_cast<double>(times[std::clamp<size_t>(rank, 1u, count) - 1u]) / 1'000'000.0;
+            };
+
+        uint64_t total = 0u;
+        for (auto it = first; it != last; ++it)
+        {
+            total += *it;
+        }
+
+        summary.FrameCount = static_cast<uint32_t>(count);
+        summary.MinMs = static_cast<double>(*first) / 1'000'000.0;
+        summary.MaxMs = static_cast<double>(*(last - 1)) / 1'000'000.0;
+        summary.AvgMs = static_cast<double>(total) / static_cast<double>(count) / 1'000'000.0;
+        summary.P95Ms = percentile(0.95);
+        summary.P99Ms = percentile(0.99);
+        return summary;
+    }
+
+    auto FormatFrameSummary() -> std::string
+    {
+        const auto summary = GetFrameSummary();
+        return std::format("frames: {} | min: {:.3f}ms | avg: {:.3f}ms | p95: {:.3f}ms | p99: {:.3f}ms | max: {:.3f}ms",
+            summary.FrameCount, summary.MinMs, summary.AvgMs, summary.P95Ms, summary.P99Ms, summary.MaxMs);
+    }
+
+    auto ExportChromeTrace(const std::filesystem::path& file) noexcept -> LS::System::ErrorCode
+    {
+        try
+        {
+            std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool isFirst = true;
+            const auto separate = [&]()
+                {
+                    if (!isFirst)
+                        json += ",\n";
+                    isFirst = false;
+                };
+
+            std::vector<ProfileEvent> events;
+            std::scoped_lock lock(g_registryLock);
+            for (const auto& buffer : g_buffers)
+            {
+                if (!buffer->Name.empty())
+                {
+                    separate();
+                    json += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", buffer->ThreadId);
+                    AppendEscaped(json, buffer->Name);
+                    json += "\"}}";
+                }
+
+                // Copy the live window, then drop whatever the owning thread overwrote during the copy
+                const auto head = buffer->Head.load(std::memory_order_acquire);
+                const auto begin = head > THREAD_EVENT_CAPACITY ? head - THREAD_EVENT_CAPACITY : 0u;
+                events.clear();
+                for (auto i = begin; i < head; ++i)
+                {
+                    events.push_back(buffer->Events[i % THREAD_EVENT_CAPACITY]);
+                }
+
+                const auto headAfter = buffer->Head.load(std::memory_order_acquire);
+                const auto overwritten = headAfter > THREAD_EVENT_CAPACITY ? headAfter - THREAD_EVENT_CAPACITY : 0u;
+                const auto skip = std::min<uint64_t>(overwritten > begin ? overwritten - begin : 0u, events.size());
+                for (auto it = events.begin() + skip; it != events.end(); ++it)
+                {
+                    separate();
+                    AppendEvent(json, *it, buffer->ThreadId);
+                }
+            }
+            json += "]}\n";
+
+            std::ofstream stream(file, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+            {
+                return LS::System::CreateFailCode(std::format("Failed to open trace file: {}", file.string()), LS::ENGINE_CODE::FILE_ERROR);
+            }
+            stream.write(json.data(), static_cast<std::streamsize>(json.size()));
+            if (!stream)
+            {
+                return LS::System::CreateFailCode("Failed to write trace file", LS::ENGINE_CODE::IO_FAIL);
+            }
+            // Exited threads' events are in the trace now, their buffers can go to new threads
+            FreeRetiredBuffers();
+        }
+        catch (const std::exception& e)
+        {
+            return LS::System::CreateFailCode(e.what(), LS::ENGINE_CODE::IO_FAIL);
+        }
+        return LS::System::CreateSuccessCode();
+    }
+}
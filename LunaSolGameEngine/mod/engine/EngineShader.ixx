@@ -84,7 +84,9 @@ export namespace LS
 
         bool operator==(const ShaderElement& v) const
         {
-            return SemanticName == v.SemanticName
+            return ShaderData == v.ShaderData
+                && SemanticName == v.SemanticName
+                && SemanticIndex == v.SemanticIndex
                 && OffsetAligned == v.OffsetAligned
                 && InputSlot == v.InputSlot
                 && InputClass == v.InputClass
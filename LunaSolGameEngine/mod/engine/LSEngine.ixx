@@ -5,19 +5,25 @@ export import Engine.App;
 export import Engine.EngineCodes;
 export import Engine.LSCamera;
 export import Engine.LSDevice;
+export import Engine.PipelineCache;
+export import Engine.CommandBucket;
 export import Engine.LSWindow;
 export import Engine.Logger;
+export import Engine.Profiler;
 export import Engine.Defines;
 export import Engine.Shader;
 export import Engine.Input;
+export import Engine.Jobs;
 
 // Objects not pertaining to engine but could, generic tools that are for all platforms
 export import Clock;
 export import LSDataLib;
 export import Helper.IO;
+export import Helper.AsyncIO;
 export import Helper.LSCommonTypes;
 export import MathLib;
 export import GeometryGenerator;
+export import MeshProcessing;
 export import Util;
 
 #ifdef LS_WIN32_BUILD
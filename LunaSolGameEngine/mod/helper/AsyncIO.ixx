@@ -0,0 +1,1236 @@
+module;
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "engine/EngineLogDefines.h"
+
+#ifdef LS_WIN32_BUILD
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#undef WIN32_LEAN_AND_MEAN
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define LS_IO_URING_AVAILABLE 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+export module Helper.AsyncIO;
+
+import Engine.EngineCodes;
+import Engine.Defines;
+import Helper.IO;
+
+namespace LS::IO
+{
+    class FileHandle;
+    class FileHandleCache;
+    struct UringQueue;
+}
+
+export namespace LS::IO
+{
+    constexpr uint64_t WHOLE_FILE = UINT64_MAX;
+
+    /**
+     * @brief How a read request delivers its bytes
+    */
+    enum class READ_MODE : uint8_t
+    {
+        COPY,//@brief Read into a caller provided or pooled buffer
+        MAPPED,//@brief Map the file read-only and return a view of the range, best for large files that are only read
+    };
+
+    /**
+     * @brief The mechanism AsyncIO uses to perform reads
+    */
+    enum class IO_BACKEND : uint8_t
+    {
+        AUTO,//@brief The thread pool. io_uring stays opt-in while its single thread opening files loses to the pool (see BenchAsyncIO).
+        THREAD_POOL,//@brief Blocking positional reads on a pool of I/O threads
+        IO_URING,//@brief One thread keeping a batch of reads in flight through io_uring (Linux only)
+    };
+
+    class BufferPool;
+
+    /**
+     * @brief A buffer borrowed from a BufferPool. It is returned to the pool when destroyed.
+    */
+    class PooledBuffer
+    {
+    public:
+        PooledBuffer() = default;
+        PooledBuffer(SharedRef<BufferPool> pool, Ref<std::byte[]> data, size_t size, size_t capacity) noexcept
+            : m_pool(std::move(pool)),
+            m_data(std::move(data)),
+            m_size(size),
+            m_capacity(capacity)
+        {
+        }
+
+        ~PooledBuffer();
+
+        PooledBuffer(const PooledBuffer&) = delete;
+        PooledBuffer& operator=(const PooledBuffer&) = delete;
+        PooledBuffer(PooledBuffer&&) noexcept = default;
+        PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+
+        [[nodiscard]] auto Data() noexcept -> std::span<std::byte>
+        {
+            return { m_data.get(), m_size };
+        }
+
+        [[nodiscard]] auto Data() const noexcept -> std::span<const std::byte>
+        {
+            return { m_data.get(), m_size };
+        }
+
+        [[nodiscard]] auto Size() const noexcept -> size_t
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] auto Capacity() const noexcept -> size_t
+        {
+            return m_capacity;
+        }
+
+        /**
+         * @brief Takes ownership of the memory so it is never returned to the pool
+        */
+        [[nodiscard]] auto Detach() noexcept -> Ref<std::byte[]>
+        {
+            m_pool.reset();
+            m_size = 0u;
+            m_capacity = 0u;
+            return std::move(m_data);
+        }
+
+    private:
+        SharedRef<BufferPool> m_pool;
+        Ref<std::byte[]> m_data;
+        size_t m_size = 0u;
+        size_t m_capacity = 0u;
+    };
+
+    /**
+     * @brief Recycles read buffers in power of two size classes so a level load does not allocate per file.
+     * Buffers larger than the biggest class are allocated exactly and freed on release.
+    */
+    class BufferPool : public std::enable_shared_from_this<BufferPool>
+    {
+        struct Private {};
+
+    public:
+        static constexpr size_t MIN_CLASS_SIZE = 4u * 1024u;
+        static constexpr size_t MAX_CLASS_SIZE = 64u * 1024u * 1024u;
+        static constexpr size_t CLASS_COUNT = 15u;// 4 KiB to 64 MiB
+
+        BufferPool(Private, size_t maxRetainedBytes) noexcept
+            : m_maxRetainedBytes(maxRetainedBytes)
+        {
+        }
+
+        /**
+         * @param maxRetainedBytes Released buffers beyond this total are freed instead of kept
+        */
+        [[nodiscard]] static auto Create(size_t maxRetainedBytes = 256u * 1024u * 1024u) -> SharedRef<BufferPool>
+        {
+            return std::make_shared<BufferPool>(Private{}, maxRetainedBytes);
+        }
+
+        /**
+         * @brief A buffer of at least @p size bytes. The contents are uninitialized.
+        */
+        [[nodiscard]] auto Acquire(size_t size) -> PooledBuffer;
+
+        /**
+         * @brief Frees every retained buffer
+        */
+        void Trim() noexcept;
+
+        [[nodiscard]] auto GetRetainedBytes() const noexcept -> size_t
+        {
+            std::scoped_lock lock(m_lock);
+            return m_retainedBytes;
+        }
+
+    private:
+        friend class PooledBuffer;
+        void Release(Ref<std::byte[]> data, size_t capacity) noexcept;
+
+        mutable std::mutex m_lock;
+        std::array<std::vector<Ref<std::byte[]>>, CLASS_COUNT> m_free;
+        size_t m_retainedBytes = 0u;
+        size_t m_maxRetainedBytes;
+    };
+
+    /**
+     * @brief A single read. Paths are opened read-only; ranges past the end of the file fail.
+    */
+    struct ReadRequest
+    {
+        std::filesystem::path Path;
+        uint64_t Offset = 0u;
+        uint64_t Length = WHOLE_FILE;//@brief Bytes to read from Offset, WHOLE_FILE reads to the end of the file
+        std::span<std::byte> Destination;//@brief Caller owned memory to read into, leave empty to use a pooled buffer
+        READ_MODE Mode = READ_MODE::COPY;
+    };
+
+    struct ReadResult
+    {
+        uint32_t Index = 0u;//@brief Position of the request in its batch
+        System::ErrorCode Result = System::CreateSuccessCode();
+        std::span<const std::byte> Data;//@brief The bytes read, a view of Destination, Buffer or Mapping
+        PooledBuffer Buffer;//@brief Owns Data when the request had no Destination
+        Nullable<MappedFile> Mapping;//@brief Owns Data for READ_MODE::MAPPED requests
+    };
+
+    /**
+     * @brief Called on an I/O thread when a read finishes. Keep it short and do not throw from it.
+    */
+    using ReadCallback = std::function<void(ReadResult&&)>;
+
+    struct AsyncIOSettings
+    {
+        IO_BACKEND Backend = IO_BACKEND::AUTO;
+        uint32_t ThreadCount = 4u;//@brief I/O threads for the thread pool backend
+        uint32_t QueueDepth = 64u;//@brief Reads kept in flight by the io_uring backend
+        uint32_t HandleCacheSize = 32u;//@brief Open files kept for reuse, 0 disables the cache
+        size_t MaxPooledBytes = 256u * 1024u * 1024u;
+    };
+
+#ifdef LS_BUILD_TESTS
+    namespace Detail
+    {
+        // Test hook: the next io_uring submission fails as if the kernel rejected it
+        inline std::atomic<bool> FailNextUringSubmit = false;
+    }
+#endif
+
+    struct AsyncIOStats
+    {
+        uint64_t Requests = 0u;
+        uint64_t Failures = 0u;
+        uint64_t BytesRead = 0u;
+        uint64_t HandleCacheHits = 0u;
+        uint64_t HandleCacheMisses = 0u;
+    };
+
+    /**
+     * @brief Performs batches of file reads in the background and reports each through a future or a callback.
+     *
+     * Requests are queued and serviced in submission order by the selected backend. Open files are kept in a
+     * small LRU cache so ranged reads into the same pack file do not reopen it. Pending reads are completed
+     * before the object is destroyed. If the kernel rejects an io_uring submission, the object switches to the
+     * thread pool backend, with AsyncIOSettings::ThreadCount threads, for the rest of its life.
+    */
+    class AsyncIO
+    {
+    public:
+        explicit AsyncIO(const AsyncIOSettings& settings = {});
+        ~AsyncIO();
+
+        AsyncIO(const AsyncIO&) = delete;
+        AsyncIO& operator=(const AsyncIO&) = delete;
+
+        [[nodiscard]] auto Read(ReadRequest request) -> std::future<ReadResult>;
+        void Read(ReadRequest request, ReadCallback onComplete);
+
+        /**
+         * @brief Queues every request at once so the backend can issue them together
+         * @return One future per request, in request order
+        */
+        [[nodiscard]] auto ReadBatch(std::vector<ReadRequest> requests) -> std::vector<std::future<ReadResult>>;
+
+        /**
+         * @brief Queues every request at once. @p onComplete is called once per request, in completion order,
+         * with ReadResult::Index identifying the request.
+        */
+        void ReadBatch(std::vector<ReadRequest> requests, ReadCallback onComplete);
+
+        /**
+         * @brief Blocks until every queued read has completed
+        */
+        void WaitIdle();
+
+        /**
+         * @brief Closes the cached file handles, e.g. after files were replaced on disk
+        */
+        void CloseHandles() noexcept;
+
+        [[nodiscard]] auto GetBackend() const noexcept -> IO_BACKEND
+        {
+            return m_backend.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] auto GetBufferPool() const noexcept -> const SharedRef<BufferPool>&
+        {
+            return m_pool;
+        }
+
+        [[nodiscard]] auto GetStats() const noexcept -> AsyncIOStats;
+
+    private:
+        struct PendingRead
+        {
+            ReadRequest Request;
+            uint32_t Index = 0u;
+            std::promise<ReadResult> Promise;
+            ReadCallback Callback;
+        };
+
+        /**
+         * @brief The open file, size and destination for a COPY read, resolved before any bytes are read
+        */
+        struct PreparedRead
+        {
+            SharedRef<FileHandle> File;
+            std::span<std::byte> Target;
+            uint64_t Offset = 0u;
+        };
+
+        void Enqueue(std::vector<PendingRead>& reads);
+        auto Prepare(PendingRead& pending, ReadResult& result) -> Nullable<PreparedRead>;
+        void Complete(PendingRead& pending, ReadResult&& result);
+        void Fail(PendingRead& pending, ReadResult&& result, System::ErrorCode error);
+
+        void PoolWorker();
+        void UringWorker();
+
+        AsyncIOSettings m_settings;
+        std::atomic<IO_BACKEND> m_backend = IO_BACKEND::THREAD_POOL;
+        SharedRef<BufferPool> m_pool;
+        Ref<FileHandleCache> m_handles;
+        Ref<UringQueue> m_uring;
+
+        std::mutex m_queueLock;
+        std::condition_variable m_queueSignal;
+        std::condition_variable m_idleSignal;
+        std::deque<PendingRead> m_queue;
+        uint64_t m_outstanding = 0u;
+        bool m_isStopping = false;
+        std::vector<std::thread> m_threads;
+        std::vector<std::thread> m_fallbackThreads;//@brief Pool threads the io_uring thread starts when it falls back
+
+        std::atomic<uint64_t> m_requests = 0u;
+        std::atomic<uint64_t> m_failures = 0u;
+        std::atomic<uint64_t> m_bytesRead = 0u;
+    };
+}
+
+module : private;
+
+namespace LS::IO
+{
+    using namespace LS::System;
+
+    /**
+     * @brief A read-only native file that supports concurrent positional reads
+    */
+    class FileHandle
+    {
+    public:
+#ifdef LS_WIN32_BUILD
+        explicit FileHandle(HANDLE file) noexcept : m_file(file) {}
+        ~FileHandle()
+        {
+            CloseHandle(m_file);
+        }
+#else
+        explicit FileHandle(int fd) noexcept : m_fd(fd) {}
+        ~FileHandle()
+        {
+            ::close(m_fd);
+        }
+
+        [[nodiscard]] auto Descriptor() const noexcept -> int
+        {
+            return m_fd;
+        }
+#endif
+
+        FileHandle(const FileHandle&) = delete;
+        FileHandle& operator=(const FileHandle&) = delete;
+
+        [[nodiscard]] static auto Open(const std::filesystem::path& path) -> SharedRef<FileHandle>
+        {
+#ifdef LS_WIN32_BUILD
+            const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return nullptr;
+            return std::make_shared<FileHandle>(file);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return nullptr;
+            return std::make_shared<FileHandle>(fd);
+#endif
+        }
+
+        /**
+         * @brief The current size of the file. Queried on every request so cached handles see files that changed.
+        */
+        [[nodiscard]] auto Size() const noexcept -> Nullable<uint64_t>
+        {
+#ifdef LS_WIN32_BUILD
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(m_file, &size))
+                return std::nullopt;
+            return static_cast<uint64_t>(size.QuadPart);
+#else
+            struct stat info {};
+            if (::fstat(m_fd, &info) != 0)
+                return std::nullopt;
+            return static_cast<uint64_t>(info.st_size);
+#endif
+        }
+
+        /**
+         * @brief Fills @p target from @p offset, retrying short reads
+         * @return False if the read failed or the file ended early
+        */
+        [[nodiscard]] bool ReadAt(std::span<std::byte> target, uint64_t offset) const noexcept
+        {
+            while (!target.empty())
+            {
+#ifdef LS_WIN32_BUILD
+                // ReadFile takes a 32-bit length, larger reads are split
+                const auto chunk = static_cast<DWORD>(std::min<size_t>(target.size(), 1u << 30));
+                OVERLAPPED position{};
+                position.Offset = static_cast<DWORD>(offset);
+                position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                DWORD read = 0;
+                if (!::ReadFile(m_file, target.data(), chunk, &read, &position) || read == 0)
+                    return false;
+#else
+                const auto read = ::pread(m_fd, target.data(), target.size(), static_cast<off_t>(offset));
+                if (read < 0 && errno == EINTR)
+                    continue;
+                if (read <= 0)
+                    return false;
+#endif
+                target = target.subspan(static_cast<size_t>(read));
+                offset += static_cast<uint64_t>(read);
+            }
+            return true;
+        }
+
+    private:
+#ifdef LS_WIN32_BUILD
+        HANDLE m_file;
+#else
+        int m_fd;
+#endif
+    };
+
+    /**
+     * @brief A least recently used cache of open files keyed by path. Evicted files close once the last read
+     * using them finishes.
+    */
+    class FileHandleCache
+    {
+        using Key = std::filesystem::path::string_type;
+        using Entry = std::pair<Key, SharedRef<FileHandle>>;
+
+    public:
+        explicit FileHandleCache(uint32_t capacity) noexcept : m_capacity(capacity) {}
+
+        [[nodiscard]] auto Acquire(const std::filesystem::path& path) -> SharedRef<FileHandle>
+        {
+            if (m_capacity == 0u)
+            {
+                m_misses.fetch_add(1u, std::memory_order_relaxed);
+                return FileHandle::Open(path);
+            }
+
+            {
+                std::scoped_lock lock(m_lock);
+                if (const auto it = m_lookup.find(path.native()); it != m_lookup.end())
+                {
+                    m_entries.splice(m_entries.begin(), m_entries, it->second);
+                    m_hits.fetch_add(1u, std::memory_order_relaxed);
+                    return it->second->second;
+                }
+            }
+
+            // Open outside the lock, another thread may race us to the same file and only one copy is kept
+            m_misses.fetch_add(1u, std::memory_order_relaxed);
+            auto file = FileHandle::Open(path);
+            if (!file)
+                return nullptr;
+
+            std::scoped_lock lock(m_lock);
+            if (const auto it = m_lookup.find(path.native()); it != m_lookup.end())
+                return it->second->second;
+
+            m_entries.emplace_front(path.native(), file);
+            m_lookup.emplace(path.native(), m_entries.begin());
+            if (m_entries.size() > m_capacity)
+            {
+                m_lookup.erase(m_entries.back().first);
+                m_entries.pop_back();
+            }
+            return file;
+        }
+
+        void Clear() noexcept
+        {
+            std::scoped_lock lock(m_lock);
+            m_lookup.clear();
+            m_entries.clear();
+        }
+
+        [[nodiscard]] auto GetHits() const noexcept -> uint64_t
+        {
+            return m_hits.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] auto GetMisses() const noexcept -> uint64_t
+        {
+            return m_misses.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::mutex m_lock;
+        std::list<Entry> m_entries;
+        std::unordered_map<Key, std::list<Entry>::iterator> m_lookup;
+        uint32_t m_capacity;
+        std::atomic<uint64_t> m_hits = 0u;
+        std::atomic<uint64_t> m_misses = 0u;
+    };
+
+#ifdef LS_IO_URING_AVAILABLE
+    /**
+     * @brief A minimal io_uring submission/completion ring driven with raw syscalls, owned by one thread
+    */
+    struct UringQueue
+    {
+        int Fd = -1;
+        uint32_t Entries = 0u;
+
+        void* SqRing = MAP_FAILED;
+        void* CqRing = MAP_FAILED;
+        size_t SqRingSize = 0u;
+        size_t CqRingSize = 0u;
+        io_uring_sqe* Sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t SqesSize = 0u;
+
+        uint32_t* SqHead = nullptr;
+        uint32_t* SqTail = nullptr;
+        uint32_t SqMask = 0u;
+        uint32_t* SqArray = nullptr;
+        uint32_t* CqHead = nullptr;
+        uint32_t* CqTail = nullptr;
+        uint32_t CqMask = 0u;
+        io_uring_cqe* Cqes = nullptr;
+
+        ~UringQueue()
+        {
+            if (Sqes != MAP_FAILED)
+                ::munmap(Sqes, SqesSize);
+            if (CqRing != MAP_FAILED && CqRing != SqRing)
+                ::munmap(CqRing, CqRingSize);
+            if (SqRing != MAP_FAILED)
+                ::munmap(SqRing, SqRingSize);
+            if (Fd >= 0)
+                ::close(Fd);
+        }
+
+        [[nodiscard]] static auto Create(uint32_t entries) -> Ref<UringQueue>
+        {
+            auto queue = std::make_unique<UringQueue>();
+            io_uring_params params{};
+            queue->Fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (queue->Fd < 0)
+                return nullptr;
+
+            queue->Entries = params.sq_entries;
+            queue->SqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            queue->CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (isSingleMap)
+            {
+                queue->SqRingSize = queue->CqRingSize = std::max(queue->SqRingSize, queue->CqRingSize);
+            }
+
+            queue->SqRing = ::mmap(nullptr, queue->SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                queue->Fd, IORING_OFF_SQ_RING);
+            if (queue->SqRing == MAP_FAILED)
+                return nullptr;
+
+            queue->CqRing = isSingleMap ? queue->SqRing : ::mmap(nullptr, queue->CqRingSize, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, queue->Fd, IORING_OFF_CQ_RING);
+            if (queue->CqRing == MAP_FAILED)
+                return nullptr;
+
+            queue->SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            queue->Sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, queue->SqesSize, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, queue->Fd, IORING_OFF_SQES));
+            if (queue->Sqes == MAP_FAILED)
+                return nullptr;
+
+            auto* sq = static_cast<std::byte*>(queue->SqRing);
+            auto* cq = static_cast<std::byte*>(queue->CqRing);
+            queue->SqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+            queue->SqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+            queue->SqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+            queue->SqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+            queue->CqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+            queue->CqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+            queue->CqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+            queue->Cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return queue;
+        }
+
+        /**
+         * @brief Queues a read; the kernel sees it on the next Enter. The caller keeps at most Entries in flight.
+        */
+        void PushRead(int fd, iovec* vec, uint64_t offset, uint64_t userData) noexcept
+        {
+            const auto tail = *SqTail;
+            const auto index = tail & SqMask;
+            auto& sqe = Sqes[index];
+            sqe = {};
+            sqe.opcode = IORING_OP_READV;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<uint64_t>(vec);
+            sqe.len = 1u;
+            sqe.off = offset;
+            sqe.user_data = userData;
+            SqArray[index] = index;
+            std::atomic_ref<uint32_t>(*SqTail).store(tail + 1u, std::memory_order_release);
+        }
+
+        /**
+         * @brief Submits @p count queued reads and optionally waits for at least @p waitFor completions
+         * @return False if the kernel rejected the submission
+        */
+        [[nodiscard]] bool Enter(uint32_t count, uint32_t waitFor) noexcept
+        {
+#ifdef LS_BUILD_TESTS
+            if (Detail::FailNextUringSubmit.exchange(false, std::memory_order_relaxed))
+                return false;
+#endif
+
+            while (count > 0u || waitFor > 0u)
+            {
+                const auto flags = waitFor > 0u ? IORING_ENTER_GETEVENTS : 0u;
+                const auto submitted = ::syscall(__NR_io_uring_enter, Fd, count, waitFor, flags, nullptr, 0);
+                if (submitted < 0)
+                {
+                    if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                        continue;
+                    return false;
+                }
+                count -= static_cast<uint32_t>(submitted);
+                waitFor = 0u;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Takes back the reads queued since the kernel last consumed the ring, after a failed Enter,
+         * so the next Enter does not submit them. @p onDiscarded receives each one's user data.
+        */
+        template <class Func>
+        void DiscardUnsubmitted(Func&& onDiscarded) noexcept
+        {
+            const auto head = std::atomic_ref<uint32_t>(*SqHead).load(std::memory_order_acquire);
+            const auto tail = *SqTail;
+            for (auto i = head; i != tail; ++i)
+            {
+                onDiscarded(Sqes[i & SqMask].user_data);
+            }
+            std::atomic_ref<uint32_t>(*SqTail).store(head, std::memory_order_release);
+        }
+
+        template <class Func>
+        void Reap(Func&& onCompletion) noexcept
+        {
+            auto head = *CqHead;
+            const auto tail = std::atomic_ref<uint32_t>(*CqTail).load(std::memory_order_acquire);
+            for (; head != tail; ++head)
+            {
+                const auto& cqe = Cqes[head & CqMask];
+                onCompletion(cqe.user_data, cqe.res);
+            }
+            std::atomic_ref<uint32_t>(*CqHead).store(head, std::memory_order_release);
+        }
+    };
+#else
+    struct UringQueue
+    {
+    };
+#endif
+
+    PooledBuffer::~PooledBuffer()
+    {
+        if (m_pool && m_data)
+            m_pool->Release(std::move(m_data), m_capacity);
+    }
+
+    PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        if (m_pool && m_data)
+            m_pool->Release(std::move(m_data), m_capacity);
+        m_pool = std::move(other.m_pool);
+        m_data = std::move(other.m_data);
+        m_size = std::exchange(other.m_size, 0u);
+        m_capacity = std::exchange(other.m_capacity, 0u);
+        return *this;
+    }
+
+    auto BufferPool::Acquire(size_t size) -> PooledBuffer
+    {
+        if (size > MAX_CLASS_SIZE)
+        {
+            return PooledBuffer(shared_from_this(), std::make_unique_for_overwrite<std::byte[]>(size), size, size);
+        }
+
+        const auto capacity = std::max(std::bit_ceil(size), MIN_CLASS_SIZE);
+        const auto sizeClass = static_cast<size_t>(std::countr_zero(capacity / MIN_CLASS_SIZE));
+        {
+            std::scoped_lock lock(m_lock);
+            auto& freeList = m_free[sizeClass];
+            if (!freeList.empty())
+            {
+                auto data = std::move(freeList.back());
+                freeList.pop_back();
+                m_retainedBytes -= capacity;
+                return PooledBuffer(shared_from_this(), std::move(data), size, capacity);
+            }
+        }
+        return PooledBuffer(shared_from_this(), std::make_unique_for_overwrite<std::byte[]>(capacity), size, capacity);
+    }
+
+    void BufferPool::Release(Ref<std::byte[]> data, size_t capacity) noexcept
+    {
+        if (capacity > MAX_CLASS_SIZE || !std::has_single_bit(capacity))
+            return;
+
+        const auto sizeClass = static_cast<size_t>(std::countr_zero(capacity / MIN_CLASS_SIZE));
+        std::scoped_lock lock(m_lock);
+        if (m_retainedBytes + capacity > m_maxRetainedBytes)
+            return;
+
+        try
+        {
+            m_free[sizeClass].emplace_back(std::move(data));
+            m_retainedBytes += capacity;
+        }
+        catch (...)
+        {
+            // Could not grow the free list, the buffer is simply freed
+        }
+    }
+
+    void BufferPool::Trim() noexcept
+    {
+        std::scoped_lock lock(m_lock);
+        for (auto& freeList : m_free)
+        {
+            freeList.clear();
+        }
+        m_retainedBytes = 0u;
+    }
+
+    AsyncIO::AsyncIO(const AsyncIOSettings& settings)
+        : m_settings(settings),
+        m_pool(BufferPool::Create(settings.MaxPooledBytes)),
+        m_handles(std::make_unique<FileHandleCache>(settings.HandleCacheSize))
+    {
+#ifdef LS_IO_URING_AVAILABLE
+        if (settings.Backend == IO_BACKEND::IO_URING)
+        {
+            m_uring = UringQueue::Create(std::max(settings.QueueDepth, 1u));
+            if (m_uring)
+            {
+                m_backend = IO_BACKEND::IO_URING;
+                m_threads.emplace_back([this] { UringWorker(); });
+                return;
+            }
+        }
+#endif
+        if (settings.Backend == IO_BACKEND::IO_URING)
+        {
+            LS_LOG_WARNING(L"io_uring is unavailable, falling back to the I/O thread pool");
+        }
+
+        m_backend = IO_BACKEND::THREAD_POOL;
+        const auto threadCount = std::max(settings.ThreadCount, 1u);
+        m_threads.reserve(threadCount);
+        for (auto i = 0u; i < threadCount; ++i)
+        {
+            m_threads.emplace_back([this] { PoolWorker(); });
+        }
+    }
+
+    AsyncIO::~AsyncIO()
+    {
+        {
+            std::scoped_lock lock(m_queueLock);
+            m_isStopping = true;
+        }
+        m_queueSignal.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+        // Only the io_uring thread starts these, and it has exited
+        for (auto& thread : m_fallbackThreads)
+        {
+            thread.join();
+        }
+    }
+
+    auto AsyncIO::Read(ReadRequest request) -> std::future<ReadResult>
+    {
+        std::vector<PendingRead> reads(1u);
+        reads[0].Request = std::move(request);
+        auto future = reads[0].Promise.get_future();
+        Enqueue(reads);
+        return future;
+    }
+
+    void AsyncIO::Read(ReadRequest request, ReadCallback onComplete)
+    {
+        std::vector<PendingRead> reads(1u);
+        reads[0].Request = std::move(request);
+        reads[0].Callback = std::move(onComplete);
+        Enqueue(reads);
+    }
+
+    auto AsyncIO::ReadBatch(std::vector<ReadRequest> requests) -> std::vector<std::future<ReadResult>>
+    {
+        std::vector<PendingRead> reads(requests.size());
+        std::vector<std::future<ReadResult>> futures;
+        futures.reserve(requests.size());
+        for (auto i = 0u; i < requests.size(); ++i)
+        {
+            reads[i].Request = std::move(requests[i]);
+            reads[i].Index = i;
+            futures.emplace_back(reads[i].Promise.get_future());
+        }
+        Enqueue(reads);
+        return futures;
+    }
+
+    void AsyncIO::ReadBatch(std::vector<ReadRequest> requests, ReadCallback onComplete)
+    {
+        std::vector<PendingRead> reads(requests.size());
+        for (auto i = 0u; i < requests.size(); ++i)
+        {
+            reads[i].Request = std::move(requests[i]);
+            reads[i].Index = i;
+            reads[i].Callback = onComplete;
+        }
+        Enqueue(reads);
+    }
+
+    void AsyncIO::Enqueue(std::vector<PendingRead>& reads)
+    {
+        if (reads.empty())
+            return;
+
+        {
+            std::scoped_lock lock(m_queueLock);
+            for (auto& read : reads)
+            {
+                m_queue.emplace_back(std::move(read));
+            }
+            m_outstanding += reads.size();
+        }
+        m_requests.fetch_add(reads.size(), std::memory_order_relaxed);
+
+        if (reads.size() == 1u || m_backend == IO_BACKEND::IO_URING)
+            m_queueSignal.notify_one();
+        else
+            m_queueSignal.notify_all();
+    }
+
+    void AsyncIO::WaitIdle()
+    {
+        std::unique_lock lock(m_queueLock);
+        m_idleSignal.wait(lock, [this] { return m_outstanding == 0u; });
+    }
+
+    void AsyncIO::CloseHandles() noexcept
+    {
+        m_handles->Clear();
+    }
+
+    auto AsyncIO::GetStats() const noexcept -> AsyncIOStats
+    {
+        return AsyncIOStats{
+            .Requests = m_requests.load(std::memory_order_relaxed),
+            .Failures = m_failures.load(std::memory_order_relaxed),
+            .BytesRead = m_bytesRead.load(std::memory_order_relaxed),
+            .HandleCacheHits = m_handles->GetHits(),
+            .HandleCacheMisses = m_handles->GetMisses(),
+        };
+    }
+
+    auto AsyncIO::Prepare(PendingRead& pending, ReadResult& result) -> Nullable<PreparedRead>
+    {
+        auto& request = pending.Request;
+        result.Index = pending.Index;
+
+        if (request.Mode == READ_MODE::MAPPED)
+        {
+            MappedFile mapping;
+            if (!mapping.Open(request.Path))
+            {
+                Fail(pending, std::move(result), CreateFailCode("Unable to map file", ENGINE_CODE::LS_ERROR_FILE_NOT_FOUND));
+                return std::nullopt;
+            }
+
+            const auto size = static_cast<uint64_t>(mapping.Size());
+            const auto length = request.Length == WHOLE_FILE ? size - std::min(request.Offset, size) : request.Length;
+            if (request.Offset > size || length > size - request.Offset)
+            {
+                Fail(pending, std::move(result), CreateFailCode("Read range is past the end of the file", ENGINE_CODE::FILE_ERROR));
+                return std::nullopt;
+            }
+
+            result.Mapping.emplace(std::move(mapping));
+            result.Data = result.Mapping->Data().subspan(static_cast<size_t>(request.Offset), static_cast<size_t>(length));
+            m_bytesRead.fetch_add(length, std::memory_order_relaxed);
+            Complete(pending, std::move(result));
+            return std::nullopt;
+        }
+
+        auto file = m_handles->Acquire(request.Path);
+        if (!file)
+        {
+            Fail(pending, std::move(result), CreateFailCode("File not found", ENGINE_CODE::LS_ERROR_FILE_NOT_FOUND));
+            return std::nullopt;
+        }
+
+        const auto size = file->Size();
+        if (!size)
+        {
+            Fail(pending, std::move(result), CreateFailCode("Unable to query file size", ENGINE_CODE::FILE_ERROR));
+            return std::nullopt;
+        }
+
+        const auto length = request.Length == WHOLE_FILE ? *size - std::min(request.Offset, *size) : request.Length;
+        if (request.Offset > *size || length > *size - request.Offset)
+        {
+            Fail(pending, std::move(result), CreateFailCode("Read range is past the end of the file", ENGINE_CODE::FILE_ERROR));
+            return std::nullopt;
+        }
+
+        std::span<std::byte> target;
+        if (!request.Destination.empty())
+        {
+            if (request.Destination.size() < length)
+            {
+                Fail(pending, std::move(result), CreateFailCode("Destination buffer is smaller than the read", ENGINE_CODE::LS_ERROR_INVALID_ARGUMENTS));
+                return std::nullopt;
+            }
+            target = request.Destination.first(static_cast<size_t>(length));
+        }
+        else
+        {
+            try
+            {
+                result.Buffer = m_pool->Acquire(static_cast<size_t>(length));
+            }
+            catch (const std::bad_alloc&)
+            {
+                Fail(pending, std::move(result), CreateFailCode("Unable to allocate a read buffer", ENGINE_CODE::HEAP_ALLOC_FAILED));
+                return std::nullopt;
+            }
+            target = result.Buffer.Data();
+        }
+
+        return PreparedRead{ .File = std::move(file), .Target = target, .Offset = request.Offset };
+    }
+
+    void AsyncIO::Complete(PendingRead& pending, ReadResult&& result)
+    {
+        if (pending.Callback)
+            pending.Callback(std::move(result));
+        else
+            pending.Promise.set_value(std::move(result));
+
+        bool isIdle = false;
+        {
+            std::scoped_lock lock(m_queueLock);
+            isIdle = --m_outstanding == 0u;
+        }
+        if (isIdle)
+            m_idleSignal.notify_all();
+    }
+
+    void AsyncIO::Fail(PendingRead& pending, ReadResult&& result, ErrorCode error)
+    {
+        LS_LOG_ERROR(std::format(L"Async read failed: {}", pending.Request.Path.wstring()));
+        m_failures.fetch_add(1u, std::memory_order_relaxed);
+        result.Result = std::move(error);
+        result.Data = {};
+        result.Buffer = {};
+        result.Mapping.reset();
+        Complete(pending, std::move(result));
+    }
+
+    void AsyncIO::PoolWorker()
+    {
+        while (true)
+        {
+            PendingRead pending;
+            {
+                std::unique_lock lock(m_queueLock);
+                m_queueSignal.wait(lock, [this] { return m_isStopping || !m_queue.empty(); });
+                // Queued reads are finished before stopping so every future is satisfied
+                if (m_queue.empty())
+                    return;
+                pending = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            ReadResult result;
+            auto prepared = Prepare(pending, result);
+            if (!prepared)
+                continue;
+
+            if (!prepared->File->ReadAt(prepared->Target, prepared->Offset))
+            {
+                Fail(pending, std::move(result), CreateFailCode("Unable to read file", ENGINE_CODE::IO_FAIL));
+                continue;
+            }
+
+            m_bytesRead.fetch_add(prepared->Target.size(), std::memory_order_relaxed);
+            result.Data = prepared->Target;
+            Complete(pending, std::move(result));
+        }
+    }
+
+    void AsyncIO::UringWorker()
+    {
+#ifdef LS_IO_URING_AVAILABLE
+        struct Slot
+        {
+            PendingRead Pending;
+            ReadResult Result;
+            PreparedRead Read;
+            size_t Done = 0u;
+            iovec Vec{};
+        };
+
+        auto& ring = *m_uring;
+        std::vector<Slot> slots(ring.Entries);
+        std::vector<uint32_t> freeSlots(ring.Entries);
+        for (auto i = 0u; i < ring.Entries; ++i)
+        {
+            freeSlots[i] = ring.Entries - 1u - i;
+        }
+
+        uint32_t inFlight = 0u;
+        uint32_t queued = 0u;
+        bool isRingUsable = true;
+        const auto pushSlot = [&](uint32_t index)
+            {
+                auto& slot = slots[index];
+                const auto remaining = slot.Read.Target.subspan(slot.Done);
+                slot.Vec = iovec{ .iov_base = remaining.data(), .iov_len = remaining.size() };
+                ring.PushRead(slot.Read.File->Descriptor(), &slot.Vec, slot.Read.Offset + slot.Done, index);
+                ++queued;
+            };
+        const auto releaseSlot = [&](uint32_t index)
+            {
+                slots[index] = Slot{};
+                freeSlots.push_back(index);
+                --inFlight;
+            };
+        const auto finishSlot = [&](uint32_t index)
+            {
+                auto& slot = slots[index];
+                m_bytesRead.fetch_add(slot.Done, std::memory_order_relaxed);
+                slot.Result.Data = slot.Read.Target;
+                Complete(slot.Pending, std::move(slot.Result));
+                releaseSlot(index);
+            };
+        const auto failSlot = [&](uint32_t index, std::string_view message)
+            {
+                Fail(slots[index].Pending, std::move(slots[index].Result), CreateFailCode(message, ENGINE_CODE::IO_FAIL));
+                releaseSlot(index);
+            };
+        const auto continueSlot = [&](uint32_t index)
+            {
+                if (isRingUsable)
+                {
+                    pushSlot(index);
+                    return;
+                }
+
+                // The ring is being drained, finish the rest with a blocking read
+                auto& slot = slots[index];
+                if (!slot.Read.File->ReadAt(slot.Read.Target.subspan(slot.Done), slot.Read.Offset + slot.Done))
+                {
+                    failSlot(index, "Unable to read file");
+                    return;
+                }
+                slot.Done = slot.Read.Target.size();
+                finishSlot(index);
+            };
+        const auto onCompletion = [&](uint64_t userData, int32_t res)
+            {
+                const auto index = static_cast<uint32_t>(userData);
+                auto& slot = slots[index];
+                if (res == -EINTR || res == -EAGAIN)
+                {
+                    continueSlot(index);
+                    return;
+                }
+                if (res <= 0)
+                {
+                    failSlot(index, "Unable to read file");
+                    return;
+                }
+
+                slot.Done += static_cast<size_t>(res);
+                if (slot.Done < slot.Read.Target.size())
+                {
+                    // Short read, queue the remainder
+                    continueSlot(index);
+                    return;
+                }
+                finishSlot(index);
+            };
+
+        while (true)
+        {
+            // Take as many new reads as there are free slots, blocking only when nothing is in flight
+            std::deque<PendingRead> incoming;
+            {
+                std::unique_lock lock(m_queueLock);
+                if (inFlight == 0u)
+                {
+                    m_queueSignal.wait(lock, [this] { return m_isStopping || !m_queue.empty(); });
+                    if (m_queue.empty())
+                        return;
+                }
+                while (!m_queue.empty() && incoming.size() < freeSlots.size())
+                {
+                    incoming.emplace_back(std::move(m_queue.front()));
+                    m_queue.pop_front();
+                }
+            }
+
+            for (auto& pending : incoming)
+            {
+                ReadResult result;
+                auto prepared = Prepare(pending, result);
+                if (!prepared)
+                    continue;
+
+                if (prepared->Target.empty())
+                {
+                    result.Data = prepared->Target;
+                    Complete(pending, std::move(result));
+                    continue;
+                }
+
+                const auto index = freeSlots.back();
+                freeSlots.pop_back();
+                auto& slot = slots[index];
+                slot.Pending = std::move(pending);
+                slot.Result = std::move(result);
+                slot.Read = std::move(*prepared);
+                ++inFlight;
+                pushSlot(index);
+            }
+
+            if (inFlight == 0u)
+                continue;
+
+            if (ring.Enter(std::exchange(queued, 0u), 1u))
+            {
+                ring.Reap(onCompletion);
+                continue;
+            }
+
+            LS_LOG_ERROR(L"io_uring submission failed, falling back to the I/O thread pool");
+            isRingUsable = false;
+            m_backend.store(IO_BACKEND::THREAD_POOL, std::memory_order_relaxed);
+
+            // Reads the kernel never saw go back to the front of the queue, in their original order
+            std::vector<uint32_t> discarded;
+            ring.DiscardUnsubmitted([&](uint64_t userData) { discarded.push_back(static_cast<uint32_t>(userData)); });
+            {
+                std::scoped_lock lock(m_queueLock);
+                for (auto it = discarded.rbegin(); it != discarded.rend(); ++it)
+                {
+                    m_queue.emplace_front(std::move(slots[*it].Pending));
+                }
+            }
+            for (const auto index : discarded)
+            {
+                releaseSlot(index);
+            }
+
+            // The kernel owns the buffers of the reads it accepted until they complete
+            while (inFlight > 0u && ring.Enter(0u, 1u))
+            {
+                ring.Reap(onCompletion);
+            }
+
+            if (inFlight > 0u)
+            {
+                // Completions cannot be waited for, so leak the buffers the kernel may still write to
+                for (auto i = 0u; i < slots.size(); ++i)
+                {
+                    if (slots[i].Read.File)
+                    {
+                        [[maybe_unused]] auto* leaked = slots[i].Result.Buffer.Detach().release();
+                        failSlot(i, "io_uring submission failed");
+                    }
+                }
+            }
+
+            // This thread becomes one of the pool's threads
+            const auto threadCount = std::max(m_settings.ThreadCount, 1u);
+            m_fallbackThreads.reserve(threadCount - 1u);
+            for (auto i = 1u; i < threadCount; ++i)
+            {
+                m_fallbackThreads.emplace_back([this] { PoolWorker(); });
+            }
+            PoolWorker();
+            return;
+        }
+#endif
+    }
+}
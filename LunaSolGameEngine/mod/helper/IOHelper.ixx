@@ -8,16 +8,24 @@ module;
 #endif
 #include <Windows.h>
 #undef WIN32_LEAN_AND_MEAN
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 export module Helper.IO;
+import <algorithm>;
 import <array>;
 import <cstddef>;
 import <filesystem>;
 import <vector>;
 import <optional>;
 import <format>;
+import <span>;
 import <string_view>;
+import <utility>;
 
 import Engine.EngineCodes;
 import Engine.Defines;
@@ -37,69 +45,247 @@ export namespace LS::IO
         ClearContent = 0x20//@brief Clear contents of an existing file
     };
 
+    /**
+     * @brief The directory containing the running executable
+     * @return The directory or an empty path if it could not be found
+    */
     auto GetParentPath() -> std::filesystem::path
     {
-#if (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+#ifdef LS_WIN32_BUILD
         std::array<wchar_t, _MAX_PATH> modulePath{};
-        if (!GetModuleFileName(nullptr, modulePath.data(), static_cast<DWORD>(modulePath.size())))
+        const auto length = GetModuleFileName(nullptr, modulePath.data(), static_cast<DWORD>(modulePath.size()));
+        if (length == 0)
+        {
+            LS_LOG_ERROR(std::format(L"Module file not found, unable to find root directory"));
+            return {};
+        }
+        std::filesystem::path modulefile(modulePath.begin(), modulePath.begin() + length);
+#else
+        std::error_code ec;
+        const auto modulefile = std::filesystem::read_symlink("/proc/self/exe", ec);
+        if (ec)
         {
             LS_LOG_ERROR(std::format(L"Module file not found, unable to find root directory"));
             return {};
         }
 #endif
-        std::filesystem::path modulefile(modulePath.begin(), modulePath.end());
         return modulefile.parent_path();
     }
 
-    auto ReadFile(std::filesystem::path path) -> Nullable<std::vector<std::byte>>
+    /**
+     * @brief Reads @p len bytes at @p offset from an open stream into a new buffer
+     * @param len The bytes to read, or std::nullopt to read from @p offset to the end
+    */
+    auto ReadStream(std::fstream& stream, const std::filesystem::path& path, Nullable<size_t> len, size_t offset) -> Nullable<std::vector<std::byte>>
     {
-        if (!std::filesystem::exists(path))
+        // The size comes from the open stream, so the file is only looked up once
+        stream.seekg(0, std::ios::end);
+        const auto fileSize = static_cast<size_t>(stream.tellg());
+        const auto readLen = len.value_or(fileSize - std::min(offset, fileSize));
+        if (offset + readLen > fileSize)
         {
-            LS_LOG_ERROR(std::format(L"File NOT found: {}", path.wstring()));
+            LS_LOG_ERROR(std::format(L"Unable to read from file. Offest ({}) + Length ({}) = {} is greater than file size: {}", offset, readLen, (offset + readLen), fileSize));
             return std::nullopt;
         }
 
+        stream.seekg(offset);
+        std::vector<std::byte> data(readLen);
+        if (!stream.read(reinterpret_cast<char*>(data.data()), readLen))
+        {
+            LS_LOG_ERROR(std::format(L"Failed to read {} bytes from file: {}", readLen, path.wstring()));
+            return std::nullopt;
+        }
+        return data;
+    }
+
+    auto ReadFile(std::filesystem::path path) -> Nullable<std::vector<std::byte>>
+    {
         std::fstream stream{ path, std::fstream::in | std::fstream::binary };
-        if (!stream.is_open() && !stream.good())
+        if (!stream.is_open())
         {
-            LS_LOG_ERROR(std::format(L"File state not good, cannot read. File: {}", path.wstring()));
+            LS_LOG_ERROR(std::format(L"File NOT found: {}", path.wstring()));
             return std::nullopt;
         }
-        auto fileSize = std::filesystem::file_size(path);
-        std::vector<std::byte> shaderData(fileSize);
-        stream.read(reinterpret_cast<char*>(shaderData.data()), fileSize);
-        stream.close();
 
-        return shaderData;
+        return ReadStream(stream, path, std::nullopt, 0u);
     }
     
     auto ReadFileSome(std::filesystem::path path, size_t len, size_t offset = 0u) -> Nullable<std::vector<std::byte>>
     {
-        if (!std::filesystem::exists(path))
+        std::fstream stream{ path, std::fstream::in | std::fstream::binary };
+        if (!stream.is_open())
         {
             LS_LOG_ERROR(std::format(L"File NOT found: {}", path.wstring()));
             return std::nullopt;
         }
 
-        std::fstream stream{ path, std::fstream::in | std::fstream::binary };
-        if (!stream.is_open() && !stream.good())
+        return ReadStream(stream, path, len, offset);
+    }
+
+    /**
+     * @brief A read-only view of a file mapped into the address space of the process.
+     * The mapping is released when the object is destroyed. Use @link LS::IO::MapFile to create one.
+    */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile()
         {
-            LS_LOG_ERROR(std::format(L"File state not good, cannot read. File: {}", path.wstring()));
-            return std::nullopt;
+            Close();
         }
 
-        auto fileSize = std::filesystem::file_size(path);
-        if (offset + len > fileSize)
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
         {
-            LS_LOG_ERROR(std::format(L"Unable to read from file. Offest ({}) + Length ({}) = {} is greater than file size: {}", offset, len, (offset + len), fileSize));
-            return std::nullopt;
+            *this = std::move(other);
         }
 
-        stream.seekg(offset);
-        std::vector<std::byte> shaderData(len);
-        stream.read(reinterpret_cast<char*>(shaderData.data()), len);
-        stream.close();
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            Close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0u);
+#ifdef LS_WIN32_BUILD
+            m_file = std::exchange(other.m_file, INVALID_HANDLE_VALUE);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+            return *this;
+        }
+
+        /**
+         * @brief Maps the entire file for reading
+         * @param path The file to map
+         * @return True if the file was mapped (an empty file maps successfully with no data)
+        */
+        [[nodiscard]] bool Open(const std::filesystem::path& path) noexcept
+        {
+            Close();
+#ifdef LS_WIN32_BUILD
+            m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(m_file, &size))
+            {
+                Close();
+                return false;
+            }
+
+            m_size = static_cast<size_t>(size.QuadPart);
+            if (m_size == 0)
+                return true;
+
+            m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping)
+            {
+                Close();
+                return false;
+            }
+
+            m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!m_data)
+            {
+                Close();
+                return false;
+            }
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            struct stat info {};
+            if (::fstat(fd, &info) != 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            m_size = static_cast<size_t>(info.st_size);
+            if (m_size == 0)
+            {
+                ::close(fd);
+                return true;
+            }
+
+            void* pData = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            // The mapping holds its own reference to the file, the descriptor is no longer needed
+            ::close(fd);
+            if (pData == MAP_FAILED)
+            {
+                m_size = 0u;
+                return false;
+            }
+            ::madvise(pData, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const std::byte*>(pData);
+#endif
+            return true;
+        }
+
+        void Close() noexcept
+        {
+#ifdef LS_WIN32_BUILD
+            if (m_data)
+                UnmapViewOfFile(m_data);
+            if (m_mapping)
+                CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE)
+                CloseHandle(m_file);
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data)
+                ::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+            m_data = nullptr;
+            m_size = 0u;
+        }
+
+        auto Data() const noexcept -> std::span<const std::byte>
+        {
+            return { m_data, m_size };
+        }
+
+        auto AsString() const noexcept -> std::string_view
+        {
+            return { reinterpret_cast<const char*>(m_data), m_size };
+        }
+
+        auto Size() const noexcept -> size_t
+        {
+            return m_size;
+        }
+
+    private:
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0u;
+#ifdef LS_WIN32_BUILD
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+
+    /**
+     * @brief Maps a file into memory for reading without copying it into a buffer
+     * @param path The file to map
+     * @return The mapped file or std::nullopt if the file could not be opened or mapped
+    */
+    auto MapFile(std::filesystem::path path) -> Nullable<MappedFile>
+    {
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            LS_LOG_ERROR(std::format(L"Unable to map file: {}", path.wstring()));
+            return std::nullopt;
+        }
 
-        return shaderData;
+        return file;
     }
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ export namespace LS
     /**
     * @brief Solid fill with back faces culled and triangles in CW order. Depth Clip Enabled (DCE)
     */
-    RasterizerInfo SolidFill_BackCull_FCW_DCE
+    constexpr RasterizerInfo SolidFill_BackCull_FCW_DCE
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::BACK,
@@ -25,7 +25,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
     
-    RasterizerInfo SolidFill_FrontCull_FCW_DCE
+    constexpr RasterizerInfo SolidFill_FrontCull_FCW_DCE
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -33,7 +33,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
     
-    RasterizerInfo SolidFill_NoneCull_FCW_DCE
+    constexpr RasterizerInfo SolidFill_NoneCull_FCW_DCE
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::NONE,
@@ -41,7 +41,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
     
-    RasterizerInfo SolidFill_BackCull_FCW_DCD
+    constexpr RasterizerInfo SolidFill_BackCull_FCW_DCD
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::BACK,
@@ -49,7 +49,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
     
-    RasterizerInfo SolidFill_FrontCull_FCW_DCD
+    constexpr RasterizerInfo SolidFill_FrontCull_FCW_DCD
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -57,7 +57,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
     
-    RasterizerInfo SolidFill_NoneCull_FCW_DCD
+    constexpr RasterizerInfo SolidFill_NoneCull_FCW_DCD
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::NONE,
@@ -68,7 +68,7 @@ export namespace LS
     /////////////////////////////////////////
     // Counter Clockwise Winding Order Set //
     /////////////////////////////////////////
-    RasterizerInfo SolidFill_BackCull_FCCW_DCE
+    constexpr RasterizerInfo SolidFill_BackCull_FCCW_DCE
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::BACK,
@@ -76,7 +76,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
     
-    RasterizerInfo SolidFill_FrontCull_FCCW_DCE
+    constexpr RasterizerInfo SolidFill_FrontCull_FCCW_DCE
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -84,7 +84,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
     
-    RasterizerInfo SolidFill_NoneCull_FCCW_DCE
+    constexpr RasterizerInfo SolidFill_NoneCull_FCCW_DCE
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::NONE,
@@ -92,7 +92,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
     
-    RasterizerInfo SolidFill_BackCull_FCCW_DCD
+    constexpr RasterizerInfo SolidFill_BackCull_FCCW_DCD
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::BACK,
@@ -100,7 +100,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
     
-    RasterizerInfo SolidFill_FrontCull_FCCW_DCD
+    constexpr RasterizerInfo SolidFill_FrontCull_FCCW_DCD
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -108,7 +108,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
     
-    RasterizerInfo SolidFill_NoneCull_FCCW_DCD
+    constexpr RasterizerInfo SolidFill_NoneCull_FCCW_DCD
     {
         .Fill = LS::FILL_STATE::FILL,
         .Cull = LS::CULL_METHOD::NONE,
@@ -124,7 +124,7 @@ export namespace LS
     /**
     * @brief Solid fill with back faces culled and triangles in CW order. Depth Clip Enabled (DCE)
     */
-    RasterizerInfo Wireframe_BackCull_FCW_DCE
+    constexpr RasterizerInfo Wireframe_BackCull_FCW_DCE
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::BACK,
@@ -132,7 +132,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
 
-    RasterizerInfo Wireframe_FrontCull_FCW_DCE
+    constexpr RasterizerInfo Wireframe_FrontCull_FCW_DCE
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -140,7 +140,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
 
-    RasterizerInfo Wireframe_NoneCull_FCW_DCE
+    constexpr RasterizerInfo Wireframe_NoneCull_FCW_DCE
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::NONE,
@@ -148,7 +148,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
 
-    RasterizerInfo Wireframe_BackCull_FCW_DCD
+    constexpr RasterizerInfo Wireframe_BackCull_FCW_DCD
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::BACK,
@@ -156,7 +156,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
 
-    RasterizerInfo Wireframe_FrontCull_FCW_DCD
+    constexpr RasterizerInfo Wireframe_FrontCull_FCW_DCD
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -164,7 +164,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
 
-    RasterizerInfo Wireframe_NoneCull_FCW_DCD
+    constexpr RasterizerInfo Wireframe_NoneCull_FCW_DCD
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::NONE,
@@ -175,7 +175,7 @@ export namespace LS
     /////////////////////////////////////////
     // Counter Clockwise Winding Order Set //
     /////////////////////////////////////////
-    RasterizerInfo Wireframe_BackCull_FCCW_DCE
+    constexpr RasterizerInfo Wireframe_BackCull_FCCW_DCE
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::BACK,
@@ -183,7 +183,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
 
-    RasterizerInfo Wireframe_FrontCull_FCCW_DCE
+    constexpr RasterizerInfo Wireframe_FrontCull_FCCW_DCE
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -191,7 +191,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
 
-    RasterizerInfo Wireframe_NoneCull_FCCW_DCE
+    constexpr RasterizerInfo Wireframe_NoneCull_FCCW_DCE
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::NONE,
@@ -199,7 +199,7 @@ export namespace LS
         .IsDepthClipEnabled = true
     };
 
-    RasterizerInfo Wireframe_BackCull_FCCW_DCD
+    constexpr RasterizerInfo Wireframe_BackCull_FCCW_DCD
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::BACK,
@@ -207,7 +207,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
 
-    RasterizerInfo Wireframe_FrontCull_FCCW_DCD
+    constexpr RasterizerInfo Wireframe_FrontCull_FCCW_DCD
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::FRONT,
@@ -215,7 +215,7 @@ export namespace LS
         .IsDepthClipEnabled = false
     };
 
-    RasterizerInfo Wireframe_NoneCull_FCCW_DCD
+    constexpr RasterizerInfo Wireframe_NoneCull_FCCW_DCD
     {
         .Fill = LS::FILL_STATE::WIREFRAME,
         .Cull = LS::CULL_METHOD::NONE,
@@ -229,7 +229,7 @@ export namespace LS
     // DEPTH STENCIL BEGIN //
     /////////////////////////
 
-    DepthStencil DepthNone
+    constexpr DepthStencil DepthNone
     {
         .IsDepthEnabled = false,
         .DepthBufferWriteAll = false,
@@ -241,7 +241,7 @@ export namespace LS
         .BackFace = { .StencilFailOp = DEPTH_STENCIL_OPS::KEEP, .StencilPassDepthFailOp = DEPTH_STENCIL_OPS::KEEP, .BothPassOp = DEPTH_STENCIL_OPS::KEEP, .StencilTestFunc = EVAL_COMPARE::ALWAYS_PASS },
     };
     
-    DepthStencil DepthDefault
+    constexpr DepthStencil DepthDefault
     {
         .IsDepthEnabled = true,
         .DepthBufferWriteAll = true,
@@ -253,7 +253,7 @@ export namespace LS
         .BackFace = { .StencilFailOp = DEPTH_STENCIL_OPS::KEEP, .StencilPassDepthFailOp = DEPTH_STENCIL_OPS::KEEP, .BothPassOp = DEPTH_STENCIL_OPS::KEEP, .StencilTestFunc = EVAL_COMPARE::ALWAYS_PASS },
     };
 
-    DepthStencil DepthRead
+    constexpr DepthStencil DepthRead
     {
         .IsDepthEnabled = true,
         .DepthBufferWriteAll = false,
@@ -265,7 +265,7 @@ export namespace LS
         .BackFace = { .StencilFailOp = DEPTH_STENCIL_OPS::KEEP, .StencilPassDepthFailOp = DEPTH_STENCIL_OPS::KEEP, .BothPassOp = DEPTH_STENCIL_OPS::KEEP, .StencilTestFunc = EVAL_COMPARE::ALWAYS_PASS },
     };
 
-    DepthStencil DepthReverseZ
+    constexpr DepthStencil DepthReverseZ
     {
         .IsDepthEnabled = true,
         .DepthBufferWriteAll = true,
@@ -277,7 +277,7 @@ export namespace LS
         .BackFace = { .StencilFailOp = DEPTH_STENCIL_OPS::KEEP, .StencilPassDepthFailOp = DEPTH_STENCIL_OPS::KEEP, .BothPassOp = DEPTH_STENCIL_OPS::KEEP, .StencilTestFunc = EVAL_COMPARE::ALWAYS_PASS },
     };
 
-    DepthStencil DepthReadReverseZ
+    constexpr DepthStencil DepthReadReverseZ
     {
         .IsDepthEnabled = true,
         .DepthBufferWriteAll = false,
@@ -289,7 +289,7 @@ export namespace LS
         .BackFace = { .StencilFailOp = DEPTH_STENCIL_OPS::KEEP, .StencilPassDepthFailOp = DEPTH_STENCIL_OPS::KEEP, .BothPassOp = DEPTH_STENCIL_OPS::KEEP, .StencilTestFunc = EVAL_COMPARE::ALWAYS_PASS },
     };
 
-    DepthStencil DepthStencilDefault
+    constexpr DepthStencil DepthStencilDefault
     {
         .IsDepthEnabled = true,
         .DepthBufferWriteAll = true,
@@ -311,6 +311,14 @@ export namespace LS
         },
     };
 
+    // The presets are already canonical, so interning one yields the same handle as any equivalent state
+    static_assert(Canonicalize(DepthNone) == DepthNone);
+    static_assert(Canonicalize(DepthDefault) == DepthDefault);
+    static_assert(Canonicalize(DepthRead) == DepthRead);
+    static_assert(Canonicalize(DepthReverseZ) == DepthReverseZ);
+    static_assert(Canonicalize(DepthReadReverseZ) == DepthReadReverseZ);
+    static_assert(Canonicalize(DepthStencilDefault) == DepthStencilDefault);
+
     /////////////////////////
     // DEPTH STENCIL END   //
     /////////////////////////
@@ -1,4 +1,5 @@
 export module MathLib;
 
 export import :MatrixMath;
-export import :GeometryMath;
\ No newline at end of file
+export import :GeometryMath;
+export import :SimdMath;
\ No newline at end of file
@@ -0,0 +1,681 @@
+module;
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <vector>
+
+// The widest instruction set compiled in. SSE2 is part of every x86-64 target, the AVX2 kernels are compiled
+// for their own target and are only used when the CPU supports them. Define LS_MATH_NO_SIMD to force the scalar paths.
+#if defined(LS_MATH_NO_SIMD)
+#define LS_SIMD_LEVEL 0
+#elif defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LS_SIMD_LEVEL 2
+#else
+#define LS_SIMD_LEVEL 0
+#endif
+
+#if LS_SIMD_LEVEL > 0
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC emits AVX instructions for AVX intrinsics without /arch:AVX2
+#define LS_TARGET_AVX2
+#else
+#define LS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+export module MathLib:SimdMath;
+import LSDataLib;
+import Engine.Defines;
+import :MatrixMath;
+
+export namespace LS::Math
+{
+    enum class SIMD_LEVEL : uint8_t
+    {
+        SCALAR = 0,// @brief Plain C++, used when no vector instructions are available
+        SSE2,// @brief 4 wide float operations
+        AVX2,// @brief 8 wide float operations
+    };
+
+    /**
+     * @brief The widest instruction set the math kernels were compiled with, the CPU may support less
+     */
+    constexpr SIMD_LEVEL MAX_SIMD_LEVEL = static_cast<SIMD_LEVEL>(LS_SIMD_LEVEL);
+
+    /**
+     * @brief The instruction set the math kernels run with, detected from the CPU at start up
+     */
+    [[nodiscard]] auto GetSimdLevel() noexcept -> SIMD_LEVEL;
+
+    /**
+     * @brief Limits the math kernels to an instruction set, e.g. to compare paths. A level the CPU does not support
+     * is lowered to the detected level.
+     * @return The level now in use
+     */
+    auto SetSimdLevel(SIMD_LEVEL level) noexcept -> SIMD_LEVEL;
+
+    /**
+     * @brief A structure of arrays stream of 3D vectors for the batch transform functions.
+     * Each component is stored in its own array so the batch paths can process 4 or 8 vectors per instruction.
+     */
+    struct Vec3Stream
+    {
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<float> Z;
+
+        void Resize(size_t count)
+        {
+            X.resize(count);
+            Y.resize(count);
+            Z.resize(count);
+        }
+
+        auto Size() const noexcept -> size_t
+        {
+            return X.size();
+        }
+
+        static auto FromVectors(std::span<const Vec3F> vectors) -> Vec3Stream
+        {
+            Vec3Stream out;
+            out.Resize(vectors.size());
+            for (auto i = 0u; i < vectors.size(); ++i)
+            {
+                out.X[i] = vectors[i].x;
+                out.Y[i] = vectors[i].y;
+                out.Z[i] = vectors[i].z;
+            }
+            return out;
+        }
+
+        /**
+         * @brief Copies the stream back into an array of vectors, out must hold at least Size() elements
+         */
+        void ToVectors(std::span<Vec3F> out) const noexcept
+        {
+            for (auto i = 0u; i < Size() && i < out.size(); ++i)
+            {
+                out[i] = Vec3F{ .x = X[i], .y = Y[i], .z = Z[i] };
+            }
+        }
+    };
+
+    // All matrices are row-major and vectors are treated as rows, so a vector is transformed as v * M and
+    // Multiply(a, b) applies a first and then b (same convention as DirectXMath).
+
+    /**
+     * @brief Scalar versions of the kernels, used as the fallback and as the reference for the SIMD versions
+     */
+    namespace Scalar
+    {
+        [[nodiscard]] constexpr auto Multiply(const Mat4F& a, const Mat4F& b) noexcept -> Mat4F
+        {
+            return MatrixMultiply(a, b);
+        }
+
+        [[nodiscard]] constexpr auto Transform(const Vec4F& v, const Mat4F& m) noexcept -> Vec4F
+        {
+            const auto& mm = m.Mat;
+            return Vec4F{
+                .x = v.x * mm[0] + v.y * mm[4] + v.z * mm[8] + v.w * mm[12],
+                .y = v.x * mm[1] + v.y * mm[5] + v.z * mm[9] + v.w * mm[13],
+                .z = v.x * mm[2] + v.y * mm[6] + v.z * mm[10] + v.w * mm[14],
+                .w = v.x * mm[3] + v.y * mm[7] + v.z * mm[11] + v.w * mm[15]
+            };
+        }
+
+        [[nodiscard]] constexpr auto Transpose(const Mat4F& m) noexcept -> Mat4F
+        {
+            Mat4F out{};
+            for (auto row = 0u; row < 4u; ++row)
+            {
+                for (auto col = 0u; col < 4u; ++col)
+                {
+                    out.Mat[col * 4 + row] = m.Mat[row * 4 + col];
+                }
+            }
+            return out;
+        }
+
+        /**
+         * @brief Inverts a general 4x4 matrix using cofactors
+         * @return The inverse, or std::nullopt if the matrix is singular
+         */
+        [[nodiscard]] auto Inverse(const Mat4F& m) noexcept -> Nullable<Mat4F>;
+
+        void TransformPoints(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept;
+        void TransformDirections(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept;
+        void Transform(const Mat4F& m, std::span<const Vec4F> in, std::span<Vec4F> out) noexcept;
+        void TransformPoints(const Mat4F& m, const Vec3Stream& in, Vec3Stream& out) noexcept;
+    }
+
+    /**
+     * @brief Multiplies two matrices (a * b)
+     */
+    [[nodiscard]] auto Multiply(const Mat4F& a, const Mat4F& b) noexcept -> Mat4F;
+
+    /**
+     * @brief Transforms a vector by the matrix (v * m)
+     */
+    [[nodiscard]] auto Transform(const Vec4F& v, const Mat4F& m) noexcept -> Vec4F;
+
+    [[nodiscard]] auto Transpose(const Mat4F& m) noexcept -> Mat4F;
+
+    /**
+     * @brief Inverts a general 4x4 matrix
+     * @return The inverse, or std::nullopt if the matrix is singular
+     */
+    [[nodiscard]] auto Inverse(const Mat4F& m) noexcept -> Nullable<Mat4F>;
+
+    /**
+     * @brief Transforms each point (w = 1) by the matrix, no perspective divide is done.
+     * out must hold at least in.size() elements and may be the same array as in.
+     */
+    void TransformPoints(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept;
+
+    /**
+     * @brief Transforms each direction (w = 0) by the matrix, translation is ignored.
+     * out must hold at least in.size() elements and may be the same array as in.
+     */
+    void TransformDirections(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept;
+
+    /**
+     * @brief Transforms each vector by the matrix. out must hold at least in.size() elements and may be the same array as in.
+     */
+    void Transform(const Mat4F& m, std::span<const Vec4F> in, std::span<Vec4F> out) noexcept;
+
+    /**
+     * @brief Transforms each point (w = 1) of the stream by the matrix, this is the fastest batch path.
+     * out is resized to match in and may be the same stream as in.
+     */
+    void TransformPoints(const Mat4F& m, const Vec3Stream& in, Vec3Stream& out) noexcept;
+}
+
+module : private;
+
+namespace LS::Math
+{
+    auto Scalar::Inverse(const Mat4F& m) noexcept -> Nullable<Mat4F>
+    {
+        const auto& a = m.Mat;
+        Mat4F out{};
+        auto& inv = out.Mat;
+
+        inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+        inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+        inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+        inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+        inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+        inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+        inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+        inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+        inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+        inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+        inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+        inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+        inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+        inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+        inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+        inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+        const float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+        if (det == 0.0f || !std::isfinite(det))
+            return std::nullopt;
+
+        const float invDet = 1.0f / det;
+        for (auto& value : inv)
+        {
+            value *= invDet;
+        }
+        return out;
+    }
+
+    void Scalar::TransformPoints(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept
+    {
+        for (auto i = 0u; i < in.size(); ++i)
+        {
+            const auto r = Transform(Vec4F{ .x = in[i].x, .y = in[i].y, .z = in[i].z, .w = 1.0f }, m);
+            out[i] = Vec3F{ .x = r.x, .y = r.y, .z = r.z };
+        }
+    }
+
+    void Scalar::TransformDirections(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept
+    {
+        for (auto i = 0u; i < in.size(); ++i)
+        {
+            const auto r = Transform(Vec4F{ .x = in[i].x, .y = in[i].y, .z = in[i].z, .w = 0.0f }, m);
+            out[i] = Vec3F{ .x = r.x, .y = r.y, .z = r.z };
+        }
+    }
+
+    void Scalar::Transform(const Mat4F& m, std::span<const Vec4F> in, std::span<Vec4F> out) noexcept
+    {
+        for (auto i = 0u; i < in.size(); ++i)
+        {
+            out[i] = Transform(in[i], m);
+        }
+    }
+
+    void Scalar::TransformPoints(const Mat4F& m, const Vec3Stream& in, Vec3Stream& out) noexcept
+    {
+        const auto& mm = m.Mat;
+        out.Resize(in.Size());
+        for (auto i = 0u; i < in.Size(); ++i)
+        {
+            const float x = in.X[i];
+            const float y = in.Y[i];
+            const float z = in.Z[i];
+            out.X[i] = x * mm[0] + y * mm[4] + z * mm[8] + mm[12];
+            out.Y[i] = x * mm[1] + y * mm[5] + z * mm[9] + mm[13];
+            out.Z[i] = x * mm[2] + y * mm[6] + z * mm[10] + mm[14];
+        }
+    }
+
+#if LS_SIMD_LEVEL > 0
+    template <int X, int Y, int Z, int W>
+    inline auto Swizzle(__m128 v) noexcept -> __m128
+    {
+        return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), _MM_SHUFFLE(W, Z, Y, X)));
+    }
+
+    template <int X, int Y, int Z, int W>
+    inline auto Shuffle(__m128 a, __m128 b) noexcept -> __m128
+    {
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+    }
+
+    inline void LoadRows(const Mat4F& m, __m128 (&rows)[4]) noexcept
+    {
+        rows[0] = _mm_loadu_ps(&m.Mat[0]);
+        rows[1] = _mm_loadu_ps(&m.Mat[4]);
+        rows[2] = _mm_loadu_ps(&m.Mat[8]);
+        rows[3] = _mm_loadu_ps(&m.Mat[12]);
+    }
+
+    /**
+     * @brief v * M for a vector held in a register, the sum of each row scaled by the vector's components
+     */
+    inline auto TransformRows(__m128 v, const __m128 (&rows)[4]) noexcept -> __m128
+    {
+        __m128 r = _mm_mul_ps(Swizzle<0, 0, 0, 0>(v), rows[0]);
+        r = _mm_add_ps(r, _mm_mul_ps(Swizzle<1, 1, 1, 1>(v), rows[1]));
+        r = _mm_add_ps(r, _mm_mul_ps(Swizzle<2, 2, 2, 2>(v), rows[2]));
+        return _mm_add_ps(r, _mm_mul_ps(Swizzle<3, 3, 3, 3>(v), rows[3]));
+    }
+
+    inline void StoreVec3(Vec3F& out, __m128 v) noexcept
+    {
+        // Only 12 bytes may be written, the next element could still be an unread input
+        _mm_storel_pi(reinterpret_cast<__m64*>(&out.x), v);
+        _mm_store_ss(&out.z, _mm_movehl_ps(v, v));
+    }
+
+    // 2x2 matrix helpers for the block inverse, each register holds a row-major 2x2 matrix
+    inline auto Mat2Mul(__m128 a, __m128 b) noexcept -> __m128
+    {
+        return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+
+    // adj(a) * b
+    inline auto Mat2AdjMul(__m128 a, __m128 b) noexcept -> __m128
+    {
+        return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+    }
+
+    // a * adj(b)
+    inline auto Mat2MulAdj(__m128 a, __m128 b) noexcept -> __m128
+    {
+        return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+
+    // AVX2 kernels, compiled for AVX2 on their own so the rest of the engine does not need an /arch or -m flag.
+    // Only called once the CPU has been checked for support.
+    LS_TARGET_AVX2 auto MultiplyAvx2(const Mat4F& a, const Mat4F& b) noexcept -> Mat4F
+    {
+        Mat4F out;
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b.Mat[0]));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b.Mat[4]));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b.Mat[8]));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b.Mat[12]));
+        // Two rows of a per register, each lane broadcasts its row's components
+        for (auto half = 0u; half < 16u; half += 8u)
+        {
+            const __m256 rows = _mm256_loadu_ps(&a.Mat[half]);
+            __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+            _mm256_storeu_ps(&out.Mat[half], r);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Transforms pairs of vectors, returns how many were transformed (the input size rounded down to even)
+     */
+    LS_TARGET_AVX2 auto TransformAvx2(const Mat4F& m, std::span<const Vec4F> in, std::span<Vec4F> out) noexcept -> size_t
+    {
+        const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.Mat[0]));
+        const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.Mat[4]));
+        const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.Mat[8]));
+        const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.Mat[12]));
+        size_t i = 0u;
+        // Two vectors per register
+        for (; i + 2u <= in.size(); i += 2u)
+        {
+            const __m256 v = _mm256_loadu_ps(&in[i].x);
+            __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0x00), r0);
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0x55), r1));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0xAA), r2));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0xFF), r3));
+            _mm256_storeu_ps(&out[i].x, r);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Transforms blocks of 8 stream points, returns how many were transformed
+     */
+    LS_TARGET_AVX2 auto TransformPointsAvx2(const Mat4F& m, const float* px, const float* py, const float* pz,
+        float* ox, float* oy, float* oz, size_t count) noexcept -> size_t
+    {
+        const auto& mm = m.Mat;
+        const __m256 m00 = _mm256_set1_ps(mm[0]), m01 = _mm256_set1_ps(mm[1]), m02 = _mm256_set1_ps(mm[2]);
+        const __m256 m10 = _mm256_set1_ps(mm[4]), m11 = _mm256_set1_ps(mm[5]), m12 = _mm256_set1_ps(mm[6]);
+        const __m256 m20 = _mm256_set1_ps(mm[8]), m21 = _mm256_set1_ps(mm[9]), m22 = _mm256_set1_ps(mm[10]);
+        const __m256 m30 = _mm256_set1_ps(mm[12]), m31 = _mm256_set1_ps(mm[13]), m32 = _mm256_set1_ps(mm[14]);
+        size_t i = 0u;
+        for (; i + 8u <= count; i += 8u)
+        {
+            const __m256 x = _mm256_loadu_ps(px + i);
+            const __m256 y = _mm256_loadu_ps(py + i);
+            const __m256 z = _mm256_loadu_ps(pz + i);
+            _mm256_storeu_ps(ox + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m00), _mm256_mul_ps(y, m10)), _mm256_add_ps(_mm256_mul_ps(z, m20), m30)));
+            _mm256_storeu_ps(oy + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m01), _mm256_mul_ps(y, m11)), _mm256_add_ps(_mm256_mul_ps(z, m21), m31)));
+            _mm256_storeu_ps(oz + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m02), _mm256_mul_ps(y, m12)), _mm256_add_ps(_mm256_mul_ps(z, m22), m32)));
+        }
+        return i;
+    }
+#endif
+
+    auto DetectSimdLevel() noexcept -> SIMD_LEVEL
+    {
+#if LS_SIMD_LEVEL >= 2
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4]{};
+        __cpuid(info, 0);
+        if (info[0] >= 7)
+        {
+            __cpuid(info, 1);
+            const bool hasAvx = (info[2] & (1 << 28)) != 0;
+            const bool hasXSave = (info[2] & (1 << 27)) != 0;
+            __cpuidex(info, 7, 0);
+            const bool hasAvx2 = (info[1] & (1 << 5)) != 0;
+            // The OS must also save the YMM registers (XCR0 bits 1 and 2) on a context switch
+            if (hasAvx && hasAvx2 && hasXSave && (_xgetbv(0) & 0x6) == 0x6)
+                return SIMD_LEVEL::AVX2;
+        }
+#else
+        // Also checks that the OS saves the YMM registers
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SIMD_LEVEL::AVX2;
+#endif
+#endif
+        return LS_SIMD_LEVEL > 0 ? SIMD_LEVEL::SSE2 : SIMD_LEVEL::SCALAR;
+    }
+
+    const SIMD_LEVEL g_detectedLevel = DetectSimdLevel();
+    // Anything that runs before this is initialized sees the zero value, the scalar paths
+    std::atomic<SIMD_LEVEL> g_simdLevel = g_detectedLevel;
+
+    inline auto ActiveLevel() noexcept -> SIMD_LEVEL
+    {
+        return g_simdLevel.load(std::memory_order_relaxed);
+    }
+
+    auto GetSimdLevel() noexcept -> SIMD_LEVEL
+    {
+        return ActiveLevel();
+    }
+
+    auto SetSimdLevel(SIMD_LEVEL level) noexcept -> SIMD_LEVEL
+    {
+        level = std::min(level, g_detectedLevel);
+        g_simdLevel.store(level, std::memory_order_relaxed);
+        return level;
+    }
+
+    auto Multiply(const Mat4F& a, const Mat4F& b) noexcept -> Mat4F
+    {
+#if LS_SIMD_LEVEL > 0
+        const auto level = ActiveLevel();
+        if (level == SIMD_LEVEL::AVX2)
+            return MultiplyAvx2(a, b);
+
+        if (level == SIMD_LEVEL::SSE2)
+        {
+            Mat4F out;
+            __m128 rows[4];
+            LoadRows(b, rows);
+            for (auto row = 0u; row < 16u; row += 4u)
+            {
+                _mm_storeu_ps(&out.Mat[row], TransformRows(_mm_loadu_ps(&a.Mat[row]), rows));
+            }
+            return out;
+        }
+#endif
+        return Scalar::Multiply(a, b);
+    }
+
+    auto Transform(const Vec4F& v, const Mat4F& m) noexcept -> Vec4F
+    {
+#if LS_SIMD_LEVEL > 0
+        if (ActiveLevel() >= SIMD_LEVEL::SSE2)
+        {
+            __m128 rows[4];
+            LoadRows(m, rows);
+            Vec4F out;
+            _mm_storeu_ps(&out.x, TransformRows(_mm_loadu_ps(&v.x), rows));
+            return out;
+        }
+#endif
+        return Scalar::Transform(v, m);
+    }
+
+    auto Transpose(const Mat4F& m) noexcept -> Mat4F
+    {
+#if LS_SIMD_LEVEL > 0
+        if (ActiveLevel() >= SIMD_LEVEL::SSE2)
+        {
+            __m128 rows[4];
+            LoadRows(m, rows);
+            _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+            Mat4F out;
+            _mm_storeu_ps(&out.Mat[0], rows[0]);
+            _mm_storeu_ps(&out.Mat[4], rows[1]);
+            _mm_storeu_ps(&out.Mat[8], rows[2]);
+            _mm_storeu_ps(&out.Mat[12], rows[3]);
+            return out;
+        }
+#endif
+        return Scalar::Transpose(m);
+    }
+
+    auto Inverse(const Mat4F& m) noexcept -> Nullable<Mat4F>
+    {
+#if LS_SIMD_LEVEL > 0
+        if (ActiveLevel() < SIMD_LEVEL::SSE2)
+            return Scalar::Inverse(m);
+
+        // Block inverse, M = | A B | with each block a 2x2 matrix
+        //                    | C D |
+        __m128 rows[4];
+        LoadRows(m, rows);
+        const __m128 A = _mm_movelh_ps(rows[0], rows[1]);
+        const __m128 B = _mm_movehl_ps(rows[1], rows[0]);
+        const __m128 C = _mm_movelh_ps(rows[2], rows[3]);
+        const __m128 D = _mm_movehl_ps(rows[3], rows[2]);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(Shuffle<0, 2, 0, 2>(rows[0], rows[2]), Shuffle<1, 3, 1, 3>(rows[1], rows[3])),
+            _mm_mul_ps(Shuffle<1, 3, 1, 3>(rows[0], rows[2]), Shuffle<0, 2, 0, 2>(rows[1], rows[3])));
+        const __m128 detA = Swizzle<0, 0, 0, 0>(detSub);
+        const __m128 detB = Swizzle<1, 1, 1, 1>(detSub);
+        const __m128 detC = Swizzle<2, 2, 2, 2>(detSub);
+        const __m128 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+        const __m128 DC = Mat2AdjMul(D, C);
+        const __m128 AB = Mat2AdjMul(A, B);
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, DC));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, AB));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, AB));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, DC));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+        __m128 trace = _mm_mul_ps(AB, Swizzle<0, 2, 1, 3>(DC));
+        trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+        trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+        const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+        const float det = _mm_cvtss_f32(detM);
+        if (det == 0.0f || !std::isfinite(det))
+            return std::nullopt;
+
+        const __m128 rcpDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        X = _mm_mul_ps(X, rcpDet);
+        Y = _mm_mul_ps(Y, rcpDet);
+        Z = _mm_mul_ps(Z, rcpDet);
+        W = _mm_mul_ps(W, rcpDet);
+
+        // Apply the adjugate and reassemble the rows
+        Mat4F out;
+        _mm_storeu_ps(&out.Mat[0], Shuffle<3, 1, 3, 1>(X, Y));
+        _mm_storeu_ps(&out.Mat[4], Shuffle<2, 0, 2, 0>(X, Y));
+        _mm_storeu_ps(&out.Mat[8], Shuffle<3, 1, 3, 1>(Z, W));
+        _mm_storeu_ps(&out.Mat[12], Shuffle<2, 0, 2, 0>(Z, W));
+        return out;
+#else
+        return Scalar::Inverse(m);
+#endif
+    }
+
+    void TransformPoints(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept
+    {
+#if LS_SIMD_LEVEL > 0
+        if (ActiveLevel() >= SIMD_LEVEL::SSE2)
+        {
+            __m128 rows[4];
+            LoadRows(m, rows);
+            for (auto i = 0u; i < in.size(); ++i)
+            {
+                __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(in[i].x), rows[0]), rows[3]);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(in[i].y), rows[1]));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(in[i].z), rows[2]));
+                StoreVec3(out[i], r);
+            }
+            return;
+        }
+#endif
+        Scalar::TransformPoints(m, in, out);
+    }
+
+    void TransformDirections(const Mat4F& m, std::span<const Vec3F> in, std::span<Vec3F> out) noexcept
+    {
+#if LS_SIMD_LEVEL > 0
+        if (ActiveLevel() >= SIMD_LEVEL::SSE2)
+        {
+            __m128 rows[4];
+            LoadRows(m, rows);
+            for (auto i = 0u; i < in.size(); ++i)
+            {
+                __m128 r = _mm_mul_ps(_mm_set1_ps(in[i].x), rows[0]);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(in[i].y), rows[1]));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(in[i].z), rows[2]));
+                StoreVec3(out[i], r);
+            }
+            return;
+        }
+#endif
+        Scalar::TransformDirections(m, in, out);
+    }
+
+    void Transform(const Mat4F& m, std::span<const Vec4F> in, std::span<Vec4F> out) noexcept
+    {
+#if LS_SIMD_LEVEL > 0
+        const auto level = ActiveLevel();
+        if (level >= SIMD_LEVEL::SSE2)
+        {
+            const size_t done = level == SIMD_LEVEL::AVX2 ? TransformAvx2(m, in, out) : 0u;
+            __m128 rows[4];
+            LoadRows(m, rows);
+            for (auto i = done; i < in.size(); ++i)
+            {
+                _mm_storeu_ps(&out[i].x, TransformRows(_mm_loadu_ps(&in[i].x), rows));
+            }
+            return;
+        }
+#endif
+        Scalar::Transform(m, in, out);
+    }
+
+    void TransformPoints(const Mat4F& m, const Vec3Stream& in, Vec3Stream& out) noexcept
+    {
+#if LS_SIMD_LEVEL > 0
+        const auto level = ActiveLevel();
+        if (level < SIMD_LEVEL::SSE2)
+        {
+            Scalar::TransformPoints(m, in, out);
+            return;
+        }
+
+        const auto& mm = m.Mat;
+        const auto count = in.Size();
+        out.Resize(count);
+
+        const float* px = in.X.data();
+        const float* py = in.Y.data();
+        const float* pz = in.Z.data();
+        float* ox = out.X.data();
+        float* oy = out.Y.data();
+        float* oz = out.Z.data();
+
+        size_t i = level == SIMD_LEVEL::AVX2 ? TransformPointsAvx2(m, px, py, pz, ox, oy, oz, count) : 0u;
+        {
+            const __m128 m00 = _mm_set1_ps(mm[0]), m01 = _mm_set1_ps(mm[1]), m02 = _mm_set1_ps(mm[2]);
+            const __m128 m10 = _mm_set1_ps(mm[4]), m11 = _mm_set1_ps(mm[5]), m12 = _mm_set1_ps(mm[6]);
+            const __m128 m20 = _mm_set1_ps(mm[8]), m21 = _mm_set1_ps(mm[9]), m22 = _mm_set1_ps(mm[10]);
+            const __m128 m30 = _mm_set1_ps(mm[12]), m31 = _mm_set1_ps(mm[13]), m32 = _mm_set1_ps(mm[14]);
+            for (; i + 4u <= count; i += 4u)
+            {
+                const __m128 x = _mm_loadu_ps(px + i);
+                const __m128 y = _mm_loadu_ps(py + i);
+                const __m128 z = _mm_loadu_ps(pz + i);
+                _mm_storeu_ps(ox + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_add_ps(_mm_mul_ps(z, m20), m30)));
+                _mm_storeu_ps(oy + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_add_ps(_mm_mul_ps(z, m21), m31)));
+                _mm_storeu_ps(oz + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_add_ps(_mm_mul_ps(z, m22), m32)));
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            const float x = px[i];
+            const float y = py[i];
+            const float z = pz[i];
+            ox[i] = x * mm[0] + y * mm[4] + z * mm[8] + mm[12];
+            oy[i] = x * mm[1] + y * mm[5] + z * mm[9] + mm[13];
+            oz[i] = x * mm[2] + y * mm[6] + z * mm[10] + mm[14];
+        }
+#else
+        Scalar::TransformPoints(m, in, out);
+#endif
+    }
+}
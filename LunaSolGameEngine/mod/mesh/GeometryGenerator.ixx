@@ -1,9 +1,15 @@
 module;
 #include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
 #include <string>
 export module GeometryGenerator;
 import Engine.Defines;
+import Engine.Jobs;
 import LSDataLib;
+import MeshProcessing;
 import <vector>;
 
 namespace LS::Geo::Generator::Detail
@@ -94,6 +100,78 @@ export namespace LS::Geo::Generator
         return points;
     }
 
+    /**
+     * @brief Creates an indexed terrain chunk at runtime, left handed with Y up. Rows and indices are generated in
+     * parallel on LS::Jobs when a scheduler is running.
+     * @param cellsX Number of cells along +X
+     * @param cellsZ Number of cells along +Z
+     * @param cellSize Size of each cell
+     * @param origin The X/Z position of the first vertex, so neighbouring chunks share their edge vertices
+     * @param height Returns the height at a world X/Z position; called from several threads at once
+     * @return (cellsX + 1) * (cellsZ + 1) vertices with clockwise triangles, or an empty mesh if that count does
+     * not fit 32-bit indices (split the terrain into chunks instead)
+     */
+    template <class HeightFunc>
+        requires std::invocable<HeightFunc&, float, float>
+    [[nodiscard]]
+    auto CreateTerrainLH(uint32_t cellsX, uint32_t cellsZ, float cellSize, Vec2F origin, HeightFunc&& height) -> Mesh::MeshData
+    {
+        Mesh::MeshData mesh;
+        const auto columns = static_cast<uint64_t>(cellsX) + 1u;
+        const auto rows = static_cast<uint64_t>(cellsZ) + 1u;
+        if (cellsX == 0u || cellsZ == 0u || cellSize <= 0.0f || columns * rows > std::numeric_limits<uint32_t>::max())
+            return mesh;
+
+        mesh.Vertices.resize(columns * rows);
+        mesh.Indices.resize(static_cast<size_t>(cellsX) * cellsZ * 6u);
+
+        LS::Jobs::ParallelFor(0u, rows, [&](size_t z)
+            {
+                for (size_t x = 0u; x < columns; ++x)
+                {
+                    const auto worldX = origin.x + x * cellSize;
+                    const auto worldZ = origin.y + z * cellSize;
+                    // Central differences give smooth normals that match across chunk edges
+                    const auto dx = height(worldX - cellSize, worldZ) - height(worldX + cellSize, worldZ);
+                    const auto dz = height(worldX, worldZ - cellSize) - height(worldX, worldZ + cellSize);
+                    const auto normalY = 2.0f * cellSize;
+                    const auto length = std::sqrt(dx * dx + normalY * normalY + dz * dz);
+
+                    auto& vertex = mesh.Vertices[z * columns + x];
+                    vertex.Position = Vec3F{ .x = worldX, .y = height(worldX, worldZ), .z = worldZ };
+                    vertex.Normal = Vec3F{ .x = dx / length, .y = normalY / length, .z = dz / length };
+                    vertex.TexCoord = Vec2F{ .x = static_cast<float>(x) / cellsX, .y = static_cast<float>(z) / cellsZ };
+                }
+            }, 16u);
+
+        LS::Jobs::ParallelFor(0u, cellsZ, [&](size_t z)
+            {
+                auto* out = &mesh.Indices[z * cellsX * 6u];
+                for (size_t x = 0u; x < cellsX; ++x)
+                {
+                    const auto v00 = static_cast<uint32_t>(z * columns + x);
+                    const auto v10 = v00 + 1u;
+                    const auto v01 = static_cast<uint32_t>(v00 + columns);
+                    const auto v11 = v01 + 1u;
+                    // Clockwise seen from +Y
+                    out[0] = v00; out[1] = v01; out[2] = v11;
+                    out[3] = v00; out[4] = v11; out[5] = v10;
+                    out += 6;
+                }
+            }, 16u);
+
+        return mesh;
+    }
+
+    /**
+     * @brief Creates a flat indexed grid at runtime on the XZ plane (see @link LS::Geo::Generator::CreateTerrainLH)
+     */
+    [[nodiscard]]
+    auto CreateGridLH(uint32_t cellsX, uint32_t cellsZ, float cellSize = 1.0f, Vec2F origin = {}) -> Mesh::MeshData
+    {
+        return CreateTerrainLH(cellsX, cellsZ, cellSize, origin, [](float, float) { return 0.0f; });
+    }
+
     /**
      * @brief Constructs a vertex array of positions for a cube. The cube generated has 8 vertices
      * @param size size of cube to make, generally want to scale with a vector and leave with default
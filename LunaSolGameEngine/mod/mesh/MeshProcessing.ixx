@@ -0,0 +1,1072 @@
+module;
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+export module MeshProcessing;
+import Engine.Defines;
+import Engine.Jobs;
+import LSDataLib;
+import Util.StdUtils;
+
+export namespace LS::Geo::Mesh
+{
+    /**
+     * @brief The vertex layout produced by the runtime generators and the welding functions
+     */
+    struct MeshVertex
+    {
+        Vec3F Position;
+        Vec3F Normal;
+        Vec2F TexCoord;
+    };
+
+    /**
+     * @brief An indexed triangle list
+     */
+    struct MeshData
+    {
+        std::vector<MeshVertex> Vertices;
+        std::vector<uint32_t> Indices;
+
+        [[nodiscard]] auto TriangleCount() const noexcept -> size_t
+        {
+            return Indices.size() / 3u;
+        }
+    };
+
+    /**
+     * @brief The post-transform cache size the optimizers target, conservative enough for current GPUs
+     */
+    constexpr uint32_t DEFAULT_CACHE_SIZE = 16u;
+
+    /**
+     * @brief How well an index buffer reuses the post-transform vertex cache (simulated as a FIFO)
+     */
+    struct VertexCacheStats
+    {
+        size_t Transformed = 0u;//@brief Vertex shader invocations
+        float Acmr = 0.0f;//@brief Average cache miss ratio, transformed vertices per triangle (0.5 is ideal for large grids, 3 is worst)
+        float Atvr = 0.0f;//@brief Average transformed to vertex ratio, transformed vertices per referenced vertex (1 is ideal)
+    };
+
+    /**
+     * @brief Simulates a FIFO post-transform cache over @p indices
+     */
+    [[nodiscard]] auto AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount,
+        uint32_t cacheSize = DEFAULT_CACHE_SIZE) -> VertexCacheStats;
+
+    /**
+     * @brief Merges bitwise identical vertices (+0 and -0 are treated as equal)
+     * @param indices The triangle list into @p vertices, or empty if @p vertices is an unindexed triangle list
+     * @return Unique vertices in first use order and the indices that reference them
+     */
+    [[nodiscard]] auto WeldVertices(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices = {}) -> MeshData;
+
+    /**
+     * @brief Builds an indexed mesh from separate position, normal and texture coordinate streams, such as the
+     * output of LS::Serialize::WavefrontObj::LoadStreamed. Corners whose normal or texture coordinate index is
+     * out of range (or whose stream is empty) get a zero attribute.
+     */
+    [[nodiscard]] auto WeldCorners(std::span<const Vec3F> positions, std::span<const Vec3F> normals,
+        std::span<const Vec2F> texCoords, std::span<const uint32_t> positionIndices,
+        std::span<const uint32_t> normalIndices, std::span<const uint32_t> texCoordIndices) -> MeshData;
+
+    /**
+     * @brief Reorders triangles for the post-transform vertex cache in linear time (Tipsify, Sander et al. 2007)
+     */
+    void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount, uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief Reorders clusters of an already cache optimized index buffer so outward facing clusters draw first,
+     * reducing overdraw. The reordered ACMR stays within @p threshold of the input's, otherwise the input is kept.
+     * @param threshold Allowed ACMR growth, 1.05 allows 5%
+     */
+    void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const MeshVertex> vertices, float threshold = 1.05f,
+        uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief Reorders the vertices in the order the indices first use them and drops unreferenced vertices
+     */
+    void OptimizeVertexFetch(MeshData& mesh);
+
+    /**
+     * @brief A 24 byte vertex. Positions are unorm16 within the mesh bounds, normals are snorm16.
+     * The fourth component of each is padding so they can be read as R16G16B16A16 formats.
+     */
+    struct QuantizedVertex
+    {
+        std::array<uint16_t, 4> Position{};
+        std::array<int16_t, 4> Normal{};
+        Vec2F TexCoord;
+    };
+
+    struct QuantizedMesh
+    {
+        std::vector<QuantizedVertex> Vertices;
+        Vec3F Offset;//@brief position = Offset + Scale * (Position / 65535)
+        Vec3F Scale;
+    };
+
+    [[nodiscard]] auto QuantizeVertices(std::span<const MeshVertex> vertices) -> QuantizedMesh;
+
+    [[nodiscard]] constexpr auto DequantizePosition(const QuantizedMesh& mesh, const QuantizedVertex& vertex) noexcept -> Vec3F
+    {
+        return Vec3F{
+            .x = mesh.Offset.x + mesh.Scale.x * (vertex.Position[0] / 65535.0f),
+            .y = mesh.Offset.y + mesh.Scale.y * (vertex.Position[1] / 65535.0f),
+            .z = mesh.Offset.z + mesh.Scale.z * (vertex.Position[2] / 65535.0f),
+        };
+    }
+
+    /**
+     * @brief One level of detail. Every level indexes the vertex buffer of the source mesh.
+     */
+    struct MeshLod
+    {
+        std::vector<uint32_t> Indices;
+        float Error = 0.0f;//@brief Approximate world space deviation from the source mesh, useful to pick a level by screen size
+    };
+
+    /**
+     * @brief Reduces a mesh toward @p targetTriangles by collapsing edges in quadric error order. Vertices on open
+     * borders and attribute seams are kept, so chunk edges still line up and the result may stop above the target.
+     */
+    [[nodiscard]] auto SimplifyMesh(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices,
+        size_t targetTriangles) -> MeshLod;
+
+    /**
+     * @brief Builds successive levels of detail, each simplified from the previous one and cache optimized
+     * @param targetTriangles Triangle count of each level, in decreasing order
+     */
+    [[nodiscard]] auto BuildLodChain(const MeshData& mesh, std::span<const size_t> targetTriangles) -> std::vector<MeshLod>;
+}
+
+module : private;
+
+namespace
+{
+    using namespace LS;
+    using namespace LS::Geo::Mesh;
+
+    constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief FIFO cache simulation with insertion stamps: a vertex is cached while fewer than cacheSize vertices
+     * were inserted after it
+     */
+    class FifoCache
+    {
+    public:
+        FifoCache(size_t vertexCount, uint32_t cacheSize)
+            : m_stamps(vertexCount, 0u),
+            m_cacheSize(cacheSize),
+            m_time(cacheSize + 1u)
+        {
+        }
+
+        /**
+         * @return True on a miss
+         */
+        bool Access(uint32_t vertex) noexcept
+        {
+            if (m_time - m_stamps[vertex] <= m_cacheSize)
+                return false;
+            m_stamps[vertex] = m_time++;
+            return true;
+        }
+
+        void Flush() noexcept
+        {
+            m_time += m_cacheSize + 1u;
+        }
+
+    private:
+        std::vector<uint32_t> m_stamps;
+        uint32_t m_cacheSize;
+        uint32_t m_time;
+    };
+
+    /**
+     * @brief Triangles around each vertex in compressed rows
+     */
+    struct TriangleAdjacency
+    {
+        std::vector<uint32_t> Offsets;
+        std::vector<uint32_t> Triangles;
+
+        TriangleAdjacency(std::span<const uint32_t> indices, size_t vertexCount)
+            : Offsets(vertexCount + 1u, 0u),
+            Triangles(indices.size())
+        {
+            for (const auto index : indices)
+            {
+                ++Offsets[index + 1u];
+            }
+            std::inclusive_scan(Offsets.begin(), Offsets.end(), Offsets.begin());
+
+            std::vector<uint32_t> fill(Offsets.begin(), Offsets.end() - 1);
+            for (size_t i = 0u; i < indices.size(); ++i)
+            {
+                Triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3u);
+            }
+        }
+
+        [[nodiscard]] auto Around(uint32_t vertex) const noexcept -> std::span<const uint32_t>
+        {
+            return std::span(Triangles).subspan(Offsets[vertex], Offsets[vertex + 1u] - Offsets[vertex]);
+        }
+    };
+
+    struct Vec3D
+    {
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+    };
+
+    constexpr auto ToDouble(const Vec3F& v) noexcept -> Vec3D
+    {
+        return { v.x, v.y, v.z };
+    }
+
+    constexpr auto Sub(const Vec3D& a, const Vec3D& b) noexcept -> Vec3D
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    constexpr auto Cross(const Vec3D& a, const Vec3D& b) noexcept -> Vec3D
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    constexpr auto Dot(const Vec3D& a, const Vec3D& b) noexcept -> double
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    auto TriangleNormal(const Vec3D& a, const Vec3D& b, const Vec3D& c) noexcept -> Vec3D
+    {
+        return Cross(Sub(b, a), Sub(c, a));
+    }
+
+    /**
+     * @brief Replaces -0 with +0 so welding and hashing treat them as the same value
+     */
+    auto Canonical(MeshVertex vertex) noexcept -> MeshVertex
+    {
+        for (auto* value : { &vertex.Position.x, &vertex.Position.y, &vertex.Position.z,
+            &vertex.Normal.x, &vertex.Normal.y, &vertex.Normal.z, &vertex.TexCoord.x, &vertex.TexCoord.y })
+        {
+            *value += 0.0f;
+        }
+        return vertex;
+    }
+
+    auto HashVertex(const MeshVertex& vertex) noexcept -> uint64_t
+    {
+        return LS::Utils::HashBytes(std::as_bytes(std::span(&vertex, 1u)));
+    }
+
+    auto IsSameVertex(const MeshVertex& a, const MeshVertex& b) noexcept -> bool
+    {
+        return std::memcmp(&a, &b, sizeof(MeshVertex)) == 0;
+    }
+
+    /**
+     * @brief Symmetric 4x4 error quadric of the squared distance to a set of planes (Garland and Heckbert 1997)
+     */
+    struct Quadric
+    {
+        std::array<double, 10> Q{};
+        double Weight = 0.0;
+
+        static auto FromPlane(const Vec3D& normal, double d, double weight) noexcept -> Quadric
+        {
+            const auto [a, b, c] = normal;
+            Quadric out;
+            out.Q = { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d };
+            for (auto& q : out.Q)
+            {
+                q *= weight;
+            }
+            out.Weight = weight;
+            return out;
+        }
+
+        Quadric& operator+=(const Quadric& rhs) noexcept
+        {
+            for (size_t i = 0u; i < Q.size(); ++i)
+            {
+                Q[i] += rhs.Q[i];
+            }
+            Weight += rhs.Weight;
+            return *this;
+        }
+
+        [[nodiscard]] auto Evaluate(const Vec3D& p) const noexcept -> double
+        {
+            const auto& q = Q;
+            return q[0] * p.x * p.x + 2.0 * q[1] * p.x * p.y + 2.0 * q[2] * p.x * p.z + 2.0 * q[3] * p.x
+                + q[4] * p.y * p.y + 2.0 * q[5] * p.y * p.z + 2.0 * q[6] * p.y
+                + q[7] * p.z * p.z + 2.0 * q[8] * p.z
+                + q[9];
+        }
+    };
+
+    /**
+     * @brief The weighted mean squared distance from @p p to the planes of both quadrics
+     */
+    auto EvaluateSum(const Quadric& a, const Quadric& b, const Vec3D& p) noexcept -> double
+    {
+        const auto weight = a.Weight + b.Weight;
+        if (weight <= 0.0)
+            return 0.0;
+        return std::max(a.Evaluate(p) + b.Evaluate(p), 0.0) / weight;
+    }
+
+    /**
+     * @brief Marks vertices that must not move: attribute seams (several vertices share a position) and open
+     * borders (an edge used by only one triangle)
+     */
+    auto FindLockedVertices(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices,
+        const TriangleAdjacency& adjacency) -> std::vector<uint8_t>
+    {
+        std::vector<uint8_t> locked(vertices.size(), 0u);
+
+        // Seams, found by hashing positions only
+        const auto tableSize = std::bit_ceil(std::max<size_t>(vertices.size() * 2u, 16u));
+        std::vector<uint32_t> table(tableSize, INVALID_INDEX);
+        for (uint32_t v = 0u; v < vertices.size(); ++v)
+        {
+            const auto position = Canonical(vertices[v]).Position;
+            auto slot = LS::Utils::HashBytes(std::as_bytes(std::span(&position, 1u))) & (tableSize - 1u);
+            while (true)
+            {
+                const auto other = table[slot];
+                if (other == INVALID_INDEX)
+                {
+                    table[slot] = v;
+                    break;
+                }
+                const auto otherPosition = Canonical(vertices[other]).Position;
+                if (std::memcmp(&position, &otherPosition, sizeof(position)) == 0)
+                {
+                    locked[v] = 1u;
+                    locked[other] = 1u;
+                    break;
+                }
+                slot = (slot + 1u) & (tableSize - 1u);
+            }
+        }
+
+        // Borders: count the triangles around a that also use b
+        const auto triangleCount = indices.size() / 3u;
+        LS::Jobs::ParallelFor(0u, triangleCount, [&](size_t first, size_t last)
+            {
+                for (auto t = first; t < last; ++t)
+                {
+                    for (auto e = 0u; e < 3u; ++e)
+                    {
+                        const auto a = indices[t * 3u + e];
+                        const auto b = indices[t * 3u + (e + 1u) % 3u];
+                        uint32_t shared = 0u;
+                        for (const auto other : adjacency.Around(a))
+                        {
+                            const auto* tri = &indices[other * 3u];
+                            shared += (tri[0] == b || tri[1] == b || tri[2] == b) ? 1u : 0u;
+                        }
+                        if (shared == 1u)
+                        {
+                            // Several edges may lock the same vertex, the store is idempotent
+                            std::atomic_ref<uint8_t>(locked[a]).store(1u, std::memory_order_relaxed);
+                            std::atomic_ref<uint8_t>(locked[b]).store(1u, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            }, 4096u);
+        return locked;
+    }
+
+    /**
+     * @brief Hard cluster boundaries for the overdraw optimizer: triangles whose three vertices all miss the cache
+     */
+    auto FindClusters(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize, float threshold) -> std::vector<uint32_t>
+    {
+        const auto triangleCount = static_cast<uint32_t>(indices.size() / 3u);
+        // Start of each hard cluster and the misses the input order has in it
+        std::vector<uint32_t> hard;
+        std::vector<uint32_t> hardMisses;
+        {
+            FifoCache cache(vertexCount, cacheSize);
+            for (uint32_t t = 0u; t < triangleCount; ++t)
+            {
+                uint32_t misses = 0u;
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    misses += cache.Access(indices[t * 3u + c]) ? 1u : 0u;
+                }
+                if (misses == 3u || t == 0u)
+                {
+                    hard.push_back(t);
+                    hardMisses.push_back(0u);
+                }
+                hardMisses.back() += misses;
+            }
+        }
+        hard.push_back(triangleCount);
+
+        // Split hard clusters further while the miss ratio, restarting with a cold cache, stays within the threshold of
+        // the input's ratio for the cluster
+        std::vector<uint32_t> soft;
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t h = 0u; h + 1u < hard.size(); ++h)
+        {
+            const auto start = hard[h];
+            const auto end = hard[h + 1u];
+            const auto clusterAcmr = static_cast<float>(hardMisses[h]) / static_cast<float>(end - start);
+
+            soft.push_back(start);
+            cache.Flush();
+            uint32_t misses = 0u;
+            uint32_t softStart = start;
+            for (auto t = start; t < end; ++t)
+            {
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    misses += cache.Access(indices[t * 3u + c]) ? 1u : 0u;
+                }
+
+                const auto count = t - softStart + 1u;
+                if (t + 1u < end && static_cast<float>(misses) / static_cast<float>(count) <= clusterAcmr * threshold)
+                {
+                    soft.push_back(t + 1u);
+                    softStart = t + 1u;
+                    misses = 0u;
+                    cache.Flush();
+                }
+            }
+        }
+        soft.push_back(triangleCount);
+        return soft;
+    }
+
+    /**
+     * @brief Tipsify's choice of the next fanning vertex, falling back to the dead-end stack and then a linear scan
+     */
+    auto NextFanVertex(std::span<const uint32_t> candidates, std::span<const uint32_t> live,
+        std::span<const uint32_t> stamps, uint32_t time, uint32_t cacheSize, std::vector<uint32_t>& deadEnd,
+        uint32_t& cursor) noexcept -> uint32_t
+    {
+        auto best = INVALID_INDEX;
+        int64_t bestPriority = -1;
+        for (const auto v : candidates)
+        {
+            if (live[v] == 0u)
+                continue;
+
+            // Prefer vertices that will still be cached after their remaining triangles are emitted
+            int64_t priority = 0;
+            const auto age = static_cast<int64_t>(time) - stamps[v];
+            if (age + 2 * static_cast<int64_t>(live[v]) <= cacheSize)
+                priority = age;
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+        if (best != INVALID_INDEX)
+            return best;
+
+        while (!deadEnd.empty())
+        {
+            const auto v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0u)
+                return v;
+        }
+
+        while (cursor < live.size())
+        {
+            const auto v = cursor++;
+            if (live[v] > 0u)
+                return v;
+        }
+        return INVALID_INDEX;
+    }
+
+    /**
+     * @brief One pass of independent edge collapses
+     * @return The number of collapses performed
+     */
+    auto CollapsePass(std::vector<uint32_t>& indices, std::span<const MeshVertex> vertices,
+        std::span<const uint8_t> locked, std::vector<Quadric>& quadrics, size_t targetTriangles, double& maxError) -> size_t
+    {
+        const auto vertexCount = vertices.size();
+        const TriangleAdjacency adjacency(indices, vertexCount);
+
+        struct Collapse
+        {
+            double Cost;
+            uint32_t From;
+            uint32_t To;
+        };
+
+        // Cheapest collapse of each free vertex onto one of its neighbours
+        std::vector<Collapse> best(vertexCount, Collapse{ std::numeric_limits<double>::max(), INVALID_INDEX, INVALID_INDEX });
+        LS::Jobs::ParallelFor(0u, vertexCount, [&](size_t first, size_t last)
+            {
+                for (auto u = static_cast<uint32_t>(first); u < last; ++u)
+                {
+                    if (locked[u])
+                        continue;
+
+                    for (const auto t : adjacency.Around(u))
+                    {
+                        for (auto c = 0u; c < 3u; ++c)
+                        {
+                            const auto v = indices[t * 3u + c];
+                            if (v == u)
+                                continue;
+
+                            const auto cost = EvaluateSum(quadrics[u], quadrics[v], ToDouble(vertices[v].Position));
+                            if (cost < best[u].Cost)
+                                best[u] = Collapse{ cost, u, v };
+                        }
+                    }
+                }
+            }, 4096u);
+
+        std::erase_if(best, [](const Collapse& c) { return c.From == INVALID_INDEX; });
+        std::sort(best.begin(), best.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+        std::vector<uint32_t> remap(vertexCount);
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::vector<uint8_t> touched(vertexCount, 0u);
+        auto triangles = indices.size() / 3u;
+        size_t collapses = 0u;
+
+        const auto remapped = [&](uint32_t t) -> std::array<uint32_t, 3>
+            {
+                return { remap[indices[t * 3u]], remap[indices[t * 3u + 1u]], remap[indices[t * 3u + 2u]] };
+            };
+        const auto isDegenerate = [](const std::array<uint32_t, 3>& tri)
+            {
+                return tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2];
+            };
+
+        // Sorted neighbours of a vertex over the triangles that are still alive after this pass's collapses
+        std::vector<uint32_t> linkU;
+        std::vector<uint32_t> linkV;
+        const auto gatherLink = [&](uint32_t vertex, std::vector<uint32_t>& link)
+            {
+                link.clear();
+                for (const auto t : adjacency.Around(vertex))
+                {
+                    const auto tri = remapped(t);
+                    if (isDegenerate(tri))
+                        continue;
+                    for (const auto w : tri)
+                    {
+                        if (w != vertex)
+                            link.push_back(w);
+                    }
+                }
+                std::sort(link.begin(), link.end());
+                link.erase(std::unique(link.begin(), link.end()), link.end());
+            };
+
+        for (const auto& collapse : best)
+        {
+            if (triangles <= targetTriangles)
+                break;
+
+            const auto u = collapse.From;
+            const auto v = collapse.To;
+            if (touched[u] || touched[v])
+                continue;
+
+            // Reject collapses that would flip a triangle around u. Neighbours collapsed earlier in this pass are
+            // seen through the remap, so only the two endpoints need to be locked.
+            const auto target = ToDouble(vertices[v].Position);
+            size_t removed = 0u;
+            bool isValid = true;
+            for (const auto t : adjacency.Around(u))
+            {
+                const auto tri = remapped(t);
+                if (isDegenerate(tri))
+                    continue;
+                if (tri[0] == v || tri[1] == v || tri[2] == v)
+                {
+                    ++removed;
+                    continue;
+                }
+
+                std::array<Vec3D, 3> before{ ToDouble(vertices[tri[0]].Position), ToDouble(vertices[tri[1]].Position), ToDouble(vertices[tri[2]].Position) };
+                auto after = before;
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    if (tri[c] == u)
+                        after[c] = target;
+                }
+                // Limiting each collapse to a 60 degree turn keeps normals from drifting over across passes,
+                // and rejects triangles that would become slivers
+                const auto n0 = TriangleNormal(before[0], before[1], before[2]);
+                const auto n1 = TriangleNormal(after[0], after[1], after[2]);
+                if (Dot(n0, n1) <= 0.5 * std::sqrt(Dot(n0, n0) * Dot(n1, n1)))
+                {
+                    isValid = false;
+                    break;
+                }
+            }
+            if (!isValid)
+                continue;
+
+            // Link condition: u and v may only share the opposite vertices of the triangles on their edge (two inside,
+            // one on a border). Any other shared neighbour would fold the surface into a non-manifold edge.
+            gatherLink(u, linkU);
+            gatherLink(v, linkV);
+            size_t shared = 0u;
+            for (auto a = linkU.begin(), b = linkV.begin(); a != linkU.end() && b != linkV.end();)
+            {
+                if (*a < *b)
+                    ++a;
+                else if (*b < *a)
+                    ++b;
+                else
+                {
+                    ++shared;
+                    ++a;
+                    ++b;
+                }
+            }
+            if (shared > removed)
+                continue;
+
+            // The opposite vertices may not be joined by an edge either: on a tetrahedron the triangles left around
+            // u would land on the ones around v
+            bool isFolded = false;
+            for (const auto t : adjacency.Around(u))
+            {
+                const auto tri = remapped(t);
+                if (isDegenerate(tri) || std::ranges::find(tri, v) != tri.end())
+                    continue;
+                for (const auto s : adjacency.Around(v))
+                {
+                    const auto other = remapped(s);
+                    if (isDegenerate(other))
+                        continue;
+                    isFolded = isFolded || std::ranges::all_of(tri, [&](uint32_t w)
+                        {
+                            return w == u || std::ranges::find(other, w) != other.end();
+                        });
+                }
+            }
+            if (isFolded)
+                continue;
+
+            touched[u] = touched[v] = 1u;
+            remap[u] = v;
+            quadrics[v] += quadrics[u];
+            maxError = std::max(maxError, collapse.Cost);
+            triangles -= removed;
+            ++collapses;
+        }
+
+        if (collapses == 0u)
+            return 0u;
+
+        size_t write = 0u;
+        for (size_t i = 0u; i < indices.size(); i += 3u)
+        {
+            const auto a = remap[indices[i]];
+            const auto b = remap[indices[i + 1u]];
+            const auto c = remap[indices[i + 2u]];
+            if (a == b || b == c || a == c)
+                continue;
+            indices[write++] = a;
+            indices[write++] = b;
+            indices[write++] = c;
+        }
+        indices.resize(write);
+        return collapses;
+    }
+}
+
+namespace LS::Geo::Mesh
+{
+    auto AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize) -> VertexCacheStats
+    {
+        VertexCacheStats stats;
+        if (indices.empty())
+            return stats;
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<uint8_t> isUsed(vertexCount, 0u);
+        size_t unique = 0u;
+        for (const auto index : indices)
+        {
+            stats.Transformed += cache.Access(index) ? 1u : 0u;
+            unique += isUsed[index] ? 0u : 1u;
+            isUsed[index] = 1u;
+        }
+
+        stats.Acmr = static_cast<float>(stats.Transformed) / static_cast<float>(indices.size() / 3u);
+        stats.Atvr = static_cast<float>(stats.Transformed) / static_cast<float>(unique);
+        return stats;
+    }
+
+    auto WeldVertices(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices) -> MeshData
+    {
+        const auto count = indices.empty() ? vertices.size() : indices.size();
+        const auto source = [&](size_t i) -> uint32_t
+            {
+                return indices.empty() ? static_cast<uint32_t>(i) : indices[i];
+            };
+
+        // Hashing is the expensive part and runs in parallel, insertion into the table is serial
+        std::vector<uint64_t> hashes(vertices.size());
+        LS::Jobs::ParallelFor(0u, vertices.size(), [&](size_t first, size_t last)
+            {
+                for (auto i = first; i < last; ++i)
+                {
+                    hashes[i] = HashVertex(Canonical(vertices[i]));
+                }
+            }, 4096u);
+
+        MeshData out;
+        out.Indices.resize(count);
+        out.Vertices.reserve(vertices.size());
+
+        const auto tableSize = std::bit_ceil(std::max<size_t>(vertices.size() * 2u, 16u));
+        std::vector<uint32_t> table(tableSize, INVALID_INDEX);
+        std::vector<uint32_t> remap(vertices.size(), INVALID_INDEX);
+        for (size_t i = 0u; i < count; ++i)
+        {
+            const auto v = source(i);
+            if (remap[v] == INVALID_INDEX)
+            {
+                const auto vertex = Canonical(vertices[v]);
+                auto slot = hashes[v] & (tableSize - 1u);
+                while (table[slot] != INVALID_INDEX && !IsSameVertex(out.Vertices[table[slot]], vertex))
+                {
+                    slot = (slot + 1u) & (tableSize - 1u);
+                }
+                if (table[slot] == INVALID_INDEX)
+                {
+                    table[slot] = static_cast<uint32_t>(out.Vertices.size());
+                    out.Vertices.push_back(vertex);
+                }
+                remap[v] = table[slot];
+            }
+            out.Indices[i] = remap[v];
+        }
+        return out;
+    }
+
+    auto WeldCorners(std::span<const Vec3F> positions, std::span<const Vec3F> normals,
+        std::span<const Vec2F> texCoords, std::span<const uint32_t> positionIndices,
+        std::span<const uint32_t> normalIndices, std::span<const uint32_t> texCoordIndices) -> MeshData
+    {
+        std::vector<MeshVertex> corners(positionIndices.size());
+        LS::Jobs::ParallelFor(0u, corners.size(), [&](size_t first, size_t last)
+            {
+                for (auto i = first; i < last; ++i)
+                {
+                    auto& corner = corners[i];
+                    const auto position = positionIndices[i];
+                    if (position < positions.size())
+                        corner.Position = positions[position];
+                    if (i < normalIndices.size() && normalIndices[i] < normals.size())
+                        corner.Normal = normals[normalIndices[i]];
+                    if (i < texCoordIndices.size() && texCoordIndices[i] < texCoords.size())
+                        corner.TexCoord = texCoords[texCoordIndices[i]];
+                }
+            }, 4096u);
+
+        return WeldVertices(corners);
+    }
+
+    void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount, uint32_t cacheSize)
+    {
+        const auto triangleCount = indices.size() / 3u;
+        if (triangleCount == 0u)
+            return;
+
+        const TriangleAdjacency adjacency(indices, vertexCount);
+        std::vector<uint32_t> live(vertexCount);
+        for (size_t v = 0u; v < vertexCount; ++v)
+        {
+            live[v] = adjacency.Offsets[v + 1u] - adjacency.Offsets[v];
+        }
+
+        std::vector<uint32_t> stamps(vertexCount, 0u);
+        std::vector<uint8_t> isEmitted(triangleCount, 0u);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+
+        uint32_t time = cacheSize + 1u;
+        uint32_t cursor = 0u;
+        auto fan = NextFanVertex({}, live, stamps, time, cacheSize, deadEnd, cursor);
+        while (fan != INVALID_INDEX)
+        {
+            candidates.clear();
+            for (const auto t : adjacency.Around(fan))
+            {
+                if (isEmitted[t])
+                    continue;
+
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    const auto v = indices[t * 3u + c];
+                    output.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - stamps[v] > cacheSize)
+                        stamps[v] = time++;
+                }
+                isEmitted[t] = 1u;
+            }
+            fan = NextFanVertex(candidates, live, stamps, time, cacheSize, deadEnd, cursor);
+        }
+
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const MeshVertex> vertices, float threshold, uint32_t cacheSize)
+    {
+        const auto triangleCount = indices.size() / 3u;
+        if (triangleCount == 0u)
+            return;
+
+        // Area weighted centroid of the whole mesh
+        Vec3D meshCentroid;
+        double meshArea = 0.0;
+        for (size_t t = 0u; t < triangleCount; ++t)
+        {
+            const auto a = ToDouble(vertices[indices[t * 3u]].Position);
+            const auto b = ToDouble(vertices[indices[t * 3u + 1u]].Position);
+            const auto c = ToDouble(vertices[indices[t * 3u + 2u]].Position);
+            const auto n = TriangleNormal(a, b, c);
+            const auto area = std::sqrt(Dot(n, n));
+            meshCentroid.x += (a.x + b.x + c.x) * area;
+            meshCentroid.y += (a.y + b.y + c.y) * area;
+            meshCentroid.z += (a.z + b.z + c.z) * area;
+            meshArea += area;
+        }
+        const auto inverseArea = meshArea > 0.0 ? 1.0 / (3.0 * meshArea) : 0.0;
+        meshCentroid = { meshCentroid.x * inverseArea, meshCentroid.y * inverseArea, meshCentroid.z * inverseArea };
+
+        // Clusters that face away from the centre are likely to occlude the rest and are drawn first
+        const auto reorder = [&](std::span<const uint32_t> clusters) -> std::vector<uint32_t>
+            {
+                const auto clusterCount = clusters.size() - 1u;
+                std::vector<double> sortKeys(clusterCount);
+                LS::Jobs::ParallelFor(0u, clusterCount, [&](size_t cluster)
+                    {
+                        Vec3D centroid;
+                        Vec3D normal;
+                        double area = 0.0;
+                        for (auto t = clusters[cluster]; t < clusters[cluster + 1u]; ++t)
+                        {
+                            const auto a = ToDouble(vertices[indices[t * 3u]].Position);
+                            const auto b = ToDouble(vertices[indices[t * 3u + 1u]].Position);
+                            const auto c = ToDouble(vertices[indices[t * 3u + 2u]].Position);
+                            const auto n = TriangleNormal(a, b, c);
+                            const auto triangleArea = std::sqrt(Dot(n, n));
+                            centroid.x += (a.x + b.x + c.x) * triangleArea;
+                            centroid.y += (a.y + b.y + c.y) * triangleArea;
+                            centroid.z += (a.z + b.z + c.z) * triangleArea;
+                            normal.x += n.x;
+                            normal.y += n.y;
+                            normal.z += n.z;
+                            area += triangleArea;
+                        }
+
+                        const auto normalLength = std::sqrt(Dot(normal, normal));
+                        if (area <= 0.0 || normalLength <= 0.0)
+                        {
+                            sortKeys[cluster] = 0.0;
+                            return;
+                        }
+                        const auto scale = 1.0 / (3.0 * area);
+                        const Vec3D offset{ centroid.x * scale - meshCentroid.x, centroid.y * scale - meshCentroid.y, centroid.z * scale - meshCentroid.z };
+                        sortKeys[cluster] = Dot(offset, normal) / normalLength;
+                    }, 64u);
+
+                std::vector<uint32_t> order(clusterCount);
+                std::iota(order.begin(), order.end(), 0u);
+                std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+                std::vector<uint32_t> output;
+                output.reserve(indices.size());
+                for (const auto cluster : order)
+                {
+                    output.insert(output.end(), indices.begin() + clusters[cluster] * 3u, indices.begin() + clusters[cluster + 1u] * 3u);
+                }
+                return output;
+            };
+
+        // The split estimate restarts every soft cluster with a cold cache and never checks the tail of a hard
+        // cluster, so the reordered buffer can still overshoot. Tighten the split threshold until it stays within
+        // the allowed growth and keep the input order if it never does.
+        const auto allowedMisses = static_cast<double>(AnalyzeVertexCache(indices, vertices.size(), cacheSize).Transformed) * threshold;
+        auto splitThreshold = threshold;
+        for (auto attempt = 0u; attempt < 4u; ++attempt)
+        {
+            const auto clusters = FindClusters(indices, vertices.size(), cacheSize, splitThreshold);
+            const auto output = reorder(clusters);
+            if (static_cast<double>(AnalyzeVertexCache(output, vertices.size(), cacheSize).Transformed) <= allowedMisses)
+            {
+                std::copy(output.begin(), output.end(), indices.begin());
+                return;
+            }
+            splitThreshold = 1.0f + (splitThreshold - 1.0f) * 0.5f;
+        }
+    }
+
+    void OptimizeVertexFetch(MeshData& mesh)
+    {
+        std::vector<uint32_t> remap(mesh.Vertices.size(), INVALID_INDEX);
+        std::vector<MeshVertex> vertices;
+        vertices.reserve(mesh.Vertices.size());
+        for (auto& index : mesh.Indices)
+        {
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = static_cast<uint32_t>(vertices.size());
+                vertices.push_back(mesh.Vertices[index]);
+            }
+            index = remap[index];
+        }
+        mesh.Vertices = std::move(vertices);
+    }
+
+    auto QuantizeVertices(std::span<const MeshVertex> vertices) -> QuantizedMesh
+    {
+        QuantizedMesh out;
+        if (vertices.empty())
+            return out;
+
+        auto minimum = vertices[0].Position;
+        auto maximum = vertices[0].Position;
+        for (const auto& vertex : vertices)
+        {
+            minimum = { std::min(minimum.x, vertex.Position.x), std::min(minimum.y, vertex.Position.y), std::min(minimum.z, vertex.Position.z) };
+            maximum = { std::max(maximum.x, vertex.Position.x), std::max(maximum.y, vertex.Position.y), std::max(maximum.z, vertex.Position.z) };
+        }
+        out.Offset = minimum;
+        out.Scale = { maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z };
+
+        const auto toUnorm = [](float value, float offset, float extent) -> uint16_t
+            {
+                if (extent <= 0.0f)
+                    return 0u;
+                const auto normalized = std::clamp((value - offset) / extent, 0.0f, 1.0f);
+                return static_cast<uint16_t>(normalized * 65535.0f + 0.5f);
+            };
+        const auto toSnorm = [](float value) -> int16_t
+            {
+                return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+            };
+
+        out.Vertices.resize(vertices.size());
+        LS::Jobs::ParallelFor(0u, vertices.size(), [&](size_t first, size_t last)
+            {
+                for (auto i = first; i < last; ++i)
+                {
+                    const auto& vertex = vertices[i];
+                    auto& quantized = out.Vertices[i];
+                    quantized.Position = {
+                        toUnorm(vertex.Position.x, out.Offset.x, out.Scale.x),
+                        toUnorm(vertex.Position.y, out.Offset.y, out.Scale.y),
+                        toUnorm(vertex.Position.z, out.Offset.z, out.Scale.z),
+                        0u };
+                    quantized.Normal = { toSnorm(vertex.Normal.x), toSnorm(vertex.Normal.y), toSnorm(vertex.Normal.z), 0 };
+                    quantized.TexCoord = vertex.TexCoord;
+                }
+            }, 4096u);
+        return out;
+    }
+
+    auto SimplifyMesh(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, size_t targetTriangles) -> MeshLod
+    {
+        MeshLod lod;
+        lod.Indices.assign(indices.begin(), indices.end());
+        const auto triangleCount = indices.size() / 3u;
+        if (triangleCount <= targetTriangles)
+            return lod;
+
+        // Plane quadrics weighted by area relative to the average triangle
+        std::vector<Quadric> quadrics(vertices.size());
+        double totalArea = 0.0;
+        for (size_t t = 0u; t < triangleCount; ++t)
+        {
+            const auto n = TriangleNormal(ToDouble(vertices[indices[t * 3u]].Position),
+                ToDouble(vertices[indices[t * 3u + 1u]].Position), ToDouble(vertices[indices[t * 3u + 2u]].Position));
+            totalArea += std::sqrt(Dot(n, n));
+        }
+        const auto averageArea = totalArea > 0.0 ? totalArea / static_cast<double>(triangleCount) : 1.0;
+
+        for (size_t t = 0u; t < triangleCount; ++t)
+        {
+            const auto a = ToDouble(vertices[indices[t * 3u]].Position);
+            const auto n = TriangleNormal(a, ToDouble(vertices[indices[t * 3u + 1u]].Position), ToDouble(vertices[indices[t * 3u + 2u]].Position));
+            const auto length = std::sqrt(Dot(n, n));
+            if (length <= 0.0)
+                continue;
+
+            const Vec3D unit{ n.x / length, n.y / length, n.z / length };
+            const auto plane = Quadric::FromPlane(unit, -Dot(unit, a), length / averageArea);
+            for (auto c = 0u; c < 3u; ++c)
+            {
+                quadrics[indices[t * 3u + c]] += plane;
+            }
+        }
+
+        const TriangleAdjacency adjacency(indices, vertices.size());
+        const auto locked = FindLockedVertices(indices, vertices, adjacency);
+
+        double maxError = 0.0;
+        while (lod.Indices.size() / 3u > targetTriangles)
+        {
+            if (CollapsePass(lod.Indices, vertices, locked, quadrics, targetTriangles, maxError) == 0u)
+                break;
+        }
+        lod.Error = static_cast<float>(std::sqrt(maxError));
+        return lod;
+    }
+
+    auto BuildLodChain(const MeshData& mesh, std::span<const size_t> targetTriangles) -> std::vector<MeshLod>
+    {
+        std::vector<MeshLod> lods;
+        lods.reserve(targetTriangles.size());
+
+        std::span<const uint32_t> source = mesh.Indices;
+        float error = 0.0f;
+        for (const auto target : targetTriangles)
+        {
+            auto lod = SimplifyMesh(source, mesh.Vertices, target);
+            OptimizeVertexCache(lod.Indices, mesh.Vertices.size());
+            // Each level starts from the previous one, so the bound against the source mesh is the sum
+            error += lod.Error;
+            lod.Error = error;
+            lods.emplace_back(std::move(lod));
+            source = lods.back().Indices;
+        }
+        return lods;
+    }
+}
@@ -1,8 +1,15 @@
 module;
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 export module Util.StdUtils;
@@ -42,4 +49,149 @@ export namespace LS::Utils
             return fs;
         return std::nullopt;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Finalizer that spreads every input bit across all output bits (MurmurHash3's fmix64)
+     */
+    constexpr auto Mix64(uint64_t value) noexcept -> uint64_t
+    {
+        value ^= value >> 33;
+        value *= 0xff51'afd7'ed55'8ccdull;
+        value ^= value >> 33;
+        value *= 0xc4ce'b9fe'1a85'ec53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    /**
+     * @brief Combines a hash value into seed, the result depends on the order values are combined
+     */
+    constexpr auto HashCombine(uint64_t seed, uint64_t value) noexcept -> uint64_t
+    {
+        return Mix64(std::rotl(seed, 27) ^ (value + 0x9e37'79b9'7f4a'7c15ull));
+    }
+
+    /**
+     * @brief A fast non-cryptographic 64-bit hash of a block of memory, reads 8 bytes per step
+     * @param data The bytes to hash
+     * @param seed Starting value, hashes with different seeds are unrelated
+     */
+    inline auto HashBytes(std::span<const std::byte> data, uint64_t seed = 0u) noexcept -> uint64_t
+    {
+        constexpr uint64_t prime = 0x9e37'79b9'7f4a'7c15ull;
+        uint64_t hash = seed ^ (data.size() * prime);
+
+        size_t i = 0u;
+        for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, data.data() + i, sizeof(word));
+            hash = std::rotl(hash ^ (word * prime), 31) * 0xc2b2'ae3d'27d4'eb4full;
+        }
+
+        if (i < data.size())
+        {
+            uint64_t tail = 0u;
+            std::memcpy(&tail, data.data() + i, data.size() - i);
+            hash = std::rotl(hash ^ (tail * prime), 31) * 0xc2b2'ae3d'27d4'eb4full;
+        }
+
+        return Mix64(hash);
+    }
+
+    /**
+     * @brief Decodes the code point at pos and moves pos past it. Invalid, overlong or cut off sequences decode to U+FFFD.
+     */
+    constexpr auto DecodeUtf8(std::string_view text, size_t& pos) noexcept -> char32_t
+    {
+        constexpr char32_t REPLACEMENT = 0xFFFD;
+        const auto lead = static_cast<unsigned char>(text[pos++]);
+        if (lead < 0x80u)
+            return lead;
+
+        size_t extra = 0u;
+        char32_t codePoint = 0u;
+        char32_t smallest = 0u;
+        if ((lead & 0xE0u) == 0xC0u)
+        {
+            extra = 1u;
+            codePoint = lead & 0x1Fu;
+            smallest = 0x80u;
+        }
+        else if ((lead & 0xF0u) == 0xE0u)
+        {
+            extra = 2u;
+            codePoint = lead & 0x0Fu;
+            smallest = 0x800u;
+        }
+        else if ((lead & 0xF8u) == 0xF0u)
+        {
+            extra = 3u;
+            codePoint = lead & 0x07u;
+            smallest = 0x10000u;
+        }
+        else
+        {
+            return REPLACEMENT;
+        }
+
+        for (auto i = 0u; i < extra; ++i)
+        {
+            // A missing continuation byte is left to be decoded on its own
+            if (pos == text.size() || (static_cast<unsigned char>(text[pos]) & 0xC0u) != 0x80u)
+                return REPLACEMENT;
+            codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[pos++]) & 0x3Fu);
+        }
+
+        if (codePoint < smallest || codePoint > 0x10FFFFu || (codePoint >= 0xD800u && codePoint <= 0xDFFFu))
+            return REPLACEMENT;
+        return codePoint;
+    }
+
+    struct WidenResult
+    {
+        size_t Written = 0u;// @brief Wide characters written
+        size_t Read = 0u;// @brief UTF-8 bytes consumed, less than the input's size when out was too small
+    };
+
+    /**
+     * @brief Converts UTF-8 to the platform's wide encoding (UTF-16 on Windows, UTF-32 elsewhere), stopping before the
+     * first character that does not fit in out
+     */
+    constexpr auto WidenUtf8(std::string_view text, std::span<wchar_t> out) noexcept -> WidenResult
+    {
+        WidenResult result;
+        while (result.Read < text.size())
+        {
+            auto pos = result.Read;
+            const auto codePoint = DecodeUtf8(text, pos);
+            if (sizeof(wchar_t) == 2u && codePoint >= 0x10000u)
+            {
+                if (out.size() - result.Written < 2u)
+                    break;
+                const auto value = codePoint - 0x10000u;
+                out[result.Written++] = static_cast<wchar_t>(0xD800u + (value >> 10));
+                out[result.Written++] = static_cast<wchar_t>(0xDC00u + (value & 0x3FFu));
+            }
+            else
+            {
+                if (result.Written == out.size())
+                    break;
+                out[result.Written++] = static_cast<wchar_t>(codePoint);
+            }
+            result.Read = pos;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Converts UTF-8 to the platform's wide encoding (UTF-16 on Windows, UTF-32 elsewhere)
+     */
+    inline auto WidenUtf8(std::string_view text) -> std::wstring
+    {
+        // A code point never needs more wide characters than it has UTF-8 bytes
+        std::wstring out(text.size(), L'\0');
+        out.resize(WidenUtf8(text, out).Written);
+        return out;
+    }
+}
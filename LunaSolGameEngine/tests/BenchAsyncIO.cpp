@@ -0,0 +1,83 @@
+#include "LSTest.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+import Helper.AsyncIO;
+import Helper.IO;
+
+namespace
+{
+    namespace fs = std::filesystem;
+    using namespace LS::IO;
+
+    constexpr uint32_t FILE_COUNT = 5000u;
+
+    /**
+     * @brief An asset folder's worth of files: mostly a few KB, one in fifty of 256 KB
+     */
+    struct AssetFiles
+    {
+        LS::Test::TempDir Dir{ "ls_bench_async_io" };
+        std::vector<fs::path> Paths;
+        uint64_t TotalBytes = 0u;
+
+        AssetFiles()
+        {
+            LS::Test::Random random(5u);
+            std::vector<char> bytes(256u * 1024u, 'x');
+            for (auto i = 0u; i < FILE_COUNT; ++i)
+            {
+                const auto value = random.Next();
+                const size_t size = i % 50u == 0u ? bytes.size() : 512u + value % 16384u;
+                auto path = Dir / ("asset" + std::to_string(i) + ".bin");
+                std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(size));
+                Paths.emplace_back(std::move(path));
+                TotalBytes += size;
+            }
+        }
+    };
+}
+
+LS_BENCHMARK(AsyncIO_FiveThousandFiles)
+{
+    const AssetFiles files;
+    std::printf("  %u files, %.1f MB, warm page cache\n", FILE_COUNT, static_cast<double>(files.TotalBytes) / (1024.0 * 1024.0));
+
+    const auto sequential = LS::Test::Measure(5u, [&]()
+        {
+            uint64_t bytes = 0u;
+            for (const auto& path : files.Paths)
+                bytes += ReadFile(path).value_or(std::vector<std::byte>{}).size();
+            LS::Test::DoNotOptimize(bytes);
+        });
+    LS::Test::Report("Sequential ReadFile", sequential);
+
+    for (const auto backend : { IO_BACKEND::THREAD_POOL, IO_BACKEND::IO_URING })
+    {
+        AsyncIO io(AsyncIOSettings{ .Backend = backend });
+        if (backend == IO_BACKEND::IO_URING && io.GetBackend() != IO_BACKEND::IO_URING)
+        {
+            std::printf("  io_uring is unavailable, skipped\n");
+            continue;
+        }
+
+        const auto samples = LS::Test::Measure(5u, [&]()
+            {
+                std::vector<ReadRequest> requests;
+                requests.reserve(files.Paths.size());
+                for (const auto& path : files.Paths)
+                    requests.push_back(ReadRequest{ .Path = path });
+
+                uint64_t bytes = 0u;
+                for (auto& future : io.ReadBatch(std::move(requests)))
+                    bytes += future.get().Data.size();
+                LS::Test::DoNotOptimize(bytes);
+            });
+        LS::Test::Report(backend == IO_BACKEND::IO_URING ? "AsyncIO ReadBatch (io_uring)" : "AsyncIO ReadBatch (thread pool)", samples);
+    }
+}
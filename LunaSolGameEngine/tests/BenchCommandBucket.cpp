@@ -0,0 +1,166 @@
+#include "LSTest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+import Engine.CommandBucket;
+import Engine.Jobs;
+import Engine.LSDevice;
+
+namespace
+{
+    using namespace LS;
+
+    constexpr uint32_t RECORDING_THREADS = 4u;
+
+    struct SceneDraw
+    {
+        uint8_t Layer = 0u;
+        uint32_t Depth = 0u;
+        StateHandle Pipeline = 0u;
+        uint32_t Material = 0u;
+        uint32_t Geometry = 0u;
+        uint32_t Count = 0u;
+    };
+
+    /**
+     * @brief A scene's worth of draws: a few layers, 256 pipelines, 4096 materials and random depths, in random order
+     */
+    auto MakeDraws(uint32_t count) -> std::vector<SceneDraw>
+    {
+        std::vector<SceneDraw> draws(count);
+        LS::Test::Random random(7u);
+        const auto next = [&random](uint32_t bound) { return random.Next(bound); };
+
+        for (auto& draw : draws)
+        {
+            draw.Layer = static_cast<uint8_t>(next(4u));
+            draw.Pipeline = next(256u);
+            draw.Material = next(4096u);
+            draw.Geometry = next(16384u);
+            draw.Count = 36u + next(3000u);
+            draw.Depth = QuantizeDepth(static_cast<float>(next(1u << 20)) / static_cast<float>(1u << 20), draw.Layer == 3u);
+        }
+        return draws;
+    }
+
+    /**
+     * @brief Records a contiguous slice of the scene into each buffer, one buffer per ParallelFor index so no two
+     * threads share a buffer
+     */
+    void Record(CommandBucket& bucket, const std::vector<SceneDraw>& draws)
+    {
+        const auto slice = (draws.size() + bucket.GetBufferCount() - 1u) / bucket.GetBufferCount();
+        LS::Jobs::ParallelFor(0u, bucket.GetBufferCount(), [&](size_t b)
+            {
+                auto& buffer = bucket.GetBuffer(static_cast<uint32_t>(b));
+                const auto first = std::min(draws.size(), b * slice);
+                const auto last = std::min(draws.size(), first + slice);
+                for (auto i = first; i < last; ++i)
+                {
+                    const auto& draw = draws[i];
+                    buffer.DrawIndexed(draw.Layer, draw.Depth, draw.Pipeline, draw.Material, draw.Geometry, draw.Count);
+                }
+            });
+    }
+
+    auto IsSameOrder(const CommandBucket& a, const CommandBucket& b) -> bool
+    {
+        if (a.Size() != b.Size())
+            return false;
+        for (auto i = 0u; i < a.Size(); ++i)
+        {
+            const auto& lhs = a.GetSorted(i);
+            const auto& rhs = b.GetSorted(i);
+            if (lhs.Key != rhs.Key || lhs.Geometry != rhs.Geometry || lhs.Count != rhs.Count)
+                return false;
+        }
+        return true;
+    }
+}
+
+LS_BENCHMARK(CommandBucket_ParallelRecord)
+{
+    const auto draws = MakeDraws(1'000'000u);
+    CommandBucket serial(1u);
+    Record(serial, draws);
+    serial.Sort();
+
+    const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    for (const auto threads : { 1u, 2u, 4u, 8u })
+    {
+        if (threads > cores)
+            break;
+        if (threads > 1u && !LS::Jobs::InitJobs(threads - 1u))
+            continue;
+
+        CommandBucket bucket(threads);
+        const auto record = LS::Test::Measure(10u, [&]()
+            {
+                bucket.Reset();
+                Record(bucket, draws);
+            });
+        LS::Test::Report("Record 1000k draws (" + std::to_string(threads) + " threads)", record);
+
+        bucket.Sort();
+        LS_CHECK(IsSameOrder(bucket, serial));
+        LS::Jobs::ShutdownJobs();
+    }
+}
+
+LS_BENCHMARK(CommandBucket_RecordSortSubmit)
+{
+    for (const auto count : { 100'000u, 1'000'000u })
+    {
+        const auto draws = MakeDraws(count);
+        const auto label = " (" + std::to_string(count / 1000u) + "k draws)";
+        CommandBucket bucket(RECORDING_THREADS);
+
+        const auto record = LS::Test::Measure(10u, [&]()
+            {
+                bucket.Reset();
+                Record(bucket, draws);
+            });
+        LS::Test::Report("Record" + label, record);
+
+        const auto sort = LS::Test::Measure(10u, [&]()
+            {
+                bucket.Sort();
+                LS::Test::DoNotOptimize(bucket.GetSorted(0u));
+            });
+        LS::Test::Report("Radix sort" + label, sort);
+
+        RecordingContext context;
+        BucketSubmitStats stats;
+        const auto submit = LS::Test::Measure(10u, [&]()
+            {
+                context.ResetCounters();
+                stats = bucket.Submit(context);
+            });
+        LS::Test::Report("Sort + submit" + label, submit);
+        std::printf("  binds: %u pipeline, %u material, %u geometry, %u skipped, %u state changes for %u draws\n",
+            stats.PipelineBinds, stats.MaterialBinds, stats.GeometryBinds, stats.RedundantBindsSkipped,
+            context.GetCounters().StateChanges(), stats.Draws);
+
+        // Baseline: a comparison sort of the packets themselves
+        std::vector<DrawPacket> scene;
+        scene.reserve(draws.size());
+        for (const auto& draw : draws)
+        {
+            scene.push_back(DrawPacket{ .Key = MakeSortKey(draw.Layer, draw.Pipeline, draw.Material, draw.Depth),
+                .Pipeline = draw.Pipeline, .Material = draw.Material, .Geometry = draw.Geometry, .Count = draw.Count });
+        }
+        std::vector<DrawPacket> packets;
+        const auto baseline = LS::Test::Measure(10u, [&]()
+            {
+                packets = scene;
+                std::stable_sort(packets.begin(), packets.end(),
+                    [](const DrawPacket& a, const DrawPacket& b) { return a.Key < b.Key; });
+                LS::Test::DoNotOptimize(packets.front());
+            });
+        LS::Test::Report("std::stable_sort of packets" + label, baseline);
+    }
+}
@@ -0,0 +1,103 @@
+#include "LSTest.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+import Engine.Jobs;
+
+namespace
+{
+    using namespace LS::Jobs;
+
+    // 0 runs every job inline on the caller, the baseline the other counts are compared against
+    auto WorkerCounts() -> std::vector<uint32_t>
+    {
+        std::vector<uint32_t> counts = { 0u, 1u, 2u, 4u };
+        const auto hardware = std::thread::hardware_concurrency();
+        if (hardware > 1u && hardware - 1u > counts.back())
+            counts.emplace_back(hardware - 1u);
+        return counts;
+    }
+
+    template <class Func>
+    void ForEachWorkerCount(Func&& func)
+    {
+        for (const auto workers : WorkerCounts())
+        {
+            if (workers > 0u && !InitJobs(workers))
+                continue;
+            func(std::to_string(workers) + (workers == 1u ? " worker" : " workers"));
+            ShutdownJobs();
+        }
+    }
+}
+
+LS_BENCHMARK(Jobs_ParallelForScaling)
+{
+    constexpr size_t COUNT = 1u << 22;
+    std::vector<float> values(COUNT, 1.5f);
+    std::printf("  %zu elements, hardware threads: %u\n", COUNT, std::thread::hardware_concurrency());
+
+    ForEachWorkerCount([&](const std::string& label)
+        {
+            const auto samples = LS::Test::Measure(20u, [&]()
+                {
+                    ParallelFor(0u, values.size(), [&](size_t first, size_t last)
+                        {
+                            for (auto i = first; i < last; ++i)
+                                values[i] = std::sqrt(values[i] * values[i] + 1.0f);
+                        }, 4096u);
+                    LS::Test::DoNotOptimize(values.front());
+                });
+            LS::Test::Report("ParallelFor sqrt x4M (" + label + ")", samples);
+        });
+}
+
+LS_BENCHMARK(Jobs_SmallJobThroughput)
+{
+    constexpr uint32_t JOBS = 100'000u;
+    ForEachWorkerCount([&](const std::string& label)
+        {
+            const auto samples = LS::Test::Measure(10u, [&]()
+                {
+                    std::atomic<uint32_t> ran = 0u;
+                    JobCounter counter;
+                    for (auto i = 0u; i < JOBS; ++i)
+                        Run([&ran]() { ran.fetch_add(1u, std::memory_order_relaxed); }, &counter);
+                    Wait(counter);
+                    LS::Test::DoNotOptimize(ran.load());
+                });
+            LS::Test::Report("Run + Wait x100k empty jobs (" + label + ")", samples);
+        });
+}
+
+LS_BENCHMARK(Jobs_NestedParallelForScaling)
+{
+    std::vector<uint32_t> data(4096u);
+    for (auto i = 0u; i < data.size(); ++i)
+        data[i] = i * 2654435761u;
+
+    ForEachWorkerCount([&](const std::string& label)
+        {
+            const auto samples = LS::Test::Measure(20u, [&]()
+                {
+                    std::atomic<uint64_t> total = 0u;
+                    ParallelFor(0u, 256u, [&](size_t)
+                        {
+                            ParallelFor(0u, data.size(), [&](size_t first, size_t last)
+                                {
+                                    uint64_t local = 0u;
+                                    for (auto i = first; i < last; ++i)
+                                        local += static_cast<uint64_t>(data[i]) * data[i];
+                                    total.fetch_add(local, std::memory_order_relaxed);
+                                }, 256u);
+                        });
+                    LS::Test::DoNotOptimize(total.load());
+                });
+            LS::Test::Report("Nested ParallelFor 256 x 4096 (" + label + ")", samples);
+        });
+}
@@ -0,0 +1,88 @@
+#include "LSTest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+import Engine.Logger;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t MESSAGES_PER_THREAD = 100'000u;
+
+    /**
+     * @brief Times every PrintLine call made by each producer thread and reports the latency percentiles in nanoseconds
+     */
+    void MeasureLatency(std::string_view name, LS::Log::LSLogger& logger, uint32_t producers)
+    {
+        std::vector<std::vector<double>> perThread(producers);
+        std::vector<std::thread> threads;
+        std::atomic<bool> go = false;
+        for (auto t = 0u; t < producers; ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    auto& samples = perThread[t];
+                    samples.reserve(MESSAGES_PER_THREAD);
+                    while (!go.load())
+                        std::this_thread::yield();
+
+                    for (auto i = 0u; i < MESSAGES_PER_THREAD; ++i)
+                    {
+                        const auto start = Clock::now();
+                        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, std::string_view("Frame finished, draws submitted and the swap chain presented"));
+                        samples.emplace_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+                    }
+                });
+        }
+
+        const auto start = Clock::now();
+        go.store(true);
+        for (auto& thread : threads)
+            thread.join();
+        const auto submitted = Clock::now();
+        logger.Flush();
+        const auto flushed = Clock::now();
+
+        LS::Test::Samples all;
+        for (auto& samples : perThread)
+            all.Ms.insert(all.Ms.end(), samples.begin(), samples.end());
+        std::sort(all.Ms.begin(), all.Ms.end());
+
+        std::printf("  %-36.*s x%u  p50 %8.0f ns  p99 %8.0f ns  p99.9 %9.0f ns  max %9.0f ns  submit %7.1f ms  drain %7.1f ms  dropped %llu\n",
+            static_cast<int>(name.size()), name.data(), producers, all.Percentile(0.5), all.Percentile(0.99), all.Percentile(0.999), all.Ms.back(),
+            std::chrono::duration<double, std::milli>(submitted - start).count(), std::chrono::duration<double, std::milli>(flushed - submitted).count(),
+            static_cast<unsigned long long>(logger.GetDroppedCount()));
+    }
+}
+
+LS_BENCHMARK(Logger_CallLatency)
+{
+    const LS::Test::TempDir dir("ls_bench_logger");
+    const auto file = dir / "bench.log";
+    const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    for (const auto producers : { 1u, 2u, 4u, 8u, 16u })
+    {
+        if (producers > cores)
+            break;
+
+        {
+            LS::Log::FileLogger logger(file);
+            MeasureLatency("FileLogger (synchronous)", logger, producers);
+        }
+        {
+            LS::Log::AsyncLogger logger(file, LS::Log::AsyncLogSettings{ .Capacity = 8192, .Overflow = LS::Log::LOG_OVERFLOW::BLOCK });
+            MeasureLatency("AsyncLogger (BLOCK, 8192)", logger, producers);
+        }
+        {
+            LS::Log::AsyncLogger logger(file, LS::Log::AsyncLogSettings{ .Capacity = 8192, .Overflow = LS::Log::LOG_OVERFLOW::DROP });
+            MeasureLatency("AsyncLogger (DROP, 8192)", logger, producers);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include "LSTest.h"
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+import LSE.Serialize.WavefrontObj;
+import LSE.Serialize.MeshCache;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    void WriteGridObj(const fs::path& path, uint32_t size)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for (auto z = 0u; z <= size; ++z)
+        {
+            for (auto x = 0u; x <= size; ++x)
+            {
+                out << std::format("v {} {} {}\n", x * 0.5f, (x ^ z) * 0.01f, z * 0.5f);
+            }
+        }
+        const auto stride = size + 1u;
+        for (auto z = 0u; z < size; ++z)
+        {
+            for (auto x = 0u; x < size; ++x)
+            {
+                const auto i = z * stride + x + 1u;
+                out << std::format("f {} {} {} {}\n", i, i + stride, i + stride + 1u, i + 1u);
+            }
+        }
+    }
+}
+
+LS_BENCHMARK(MeshCache_ParseVsCachedLoad)
+{
+    const LS::Test::TempDir dir("ls_bench_mesh_cache");
+    const auto obj = dir / "grid.obj";
+    const auto cacheFile = dir / "grid.lsmc";
+    WriteGridObj(obj, 1024u);
+
+    const auto parse = LS::Test::Measure(5u, [&]()
+        {
+            LS::Serialize::WavefrontObj mesh;
+            [[maybe_unused]] auto loaded = mesh.LoadStreamed(obj);
+            LS::Test::DoNotOptimize(mesh);
+        });
+    LS::Test::Report("LoadStreamed (no cache)", parse);
+
+    const auto rebuild = LS::Test::Measure(5u, [&]()
+        {
+            std::error_code ec;
+            fs::remove(cacheFile, ec);
+            LS::Serialize::MeshCache cache;
+            [[maybe_unused]] auto loaded = LS::Serialize::LoadMeshCached(obj, cacheFile, cache);
+            LS::Test::DoNotOptimize(cache);
+        });
+    LS::Test::Report("LoadMeshCached (cache missing, rebuilt)", rebuild);
+
+    const auto current = LS::Test::Measure(20u, [&]()
+        {
+            LS::Serialize::MeshCache cache;
+            [[maybe_unused]] auto loaded = LS::Serialize::LoadMeshCached(obj, cacheFile, cache);
+            LS::Test::DoNotOptimize(cache);
+        });
+    LS::Test::Report("LoadMeshCached (cache current)", current);
+
+    // Each load follows a touch, so it hashes the source once and refreshes the header
+    const auto touched = LS::Test::Measure(20u, [&]()
+        {
+            fs::last_write_time(obj, fs::last_write_time(obj) + std::chrono::seconds(1));
+            LS::Serialize::MeshCache cache;
+            [[maybe_unused]] auto loaded = LS::Serialize::LoadMeshCached(obj, cacheFile, cache);
+            LS::Test::DoNotOptimize(cache);
+        });
+    LS::Test::Report("LoadMeshCached (source touched, hashed)", touched);
+}
@@ -0,0 +1,184 @@
+#include "LSTest.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+import MeshProcessing;
+import GeometryGenerator;
+
+namespace
+{
+    using namespace LS::Geo;
+
+    // 1536 x 1024 cells, about 3.1M triangles
+    constexpr uint32_t TERRAIN_COLUMNS = 1536u;
+    constexpr uint32_t TERRAIN_ROWS = 1024u;
+
+    auto Hills(float x, float z) -> float
+    {
+        return std::sin(x * 0.3f) * std::cos(z * 0.2f) * 2.0f;
+    }
+
+    auto CreateTerrain() -> Mesh::MeshData
+    {
+        return Generator::CreateTerrainLH(TERRAIN_COLUMNS, TERRAIN_ROWS, 1.0f, {}, Hills);
+    }
+
+    void PrintStats(const char* label, const Mesh::VertexCacheStats& stats)
+    {
+        std::printf("  %-32s ACMR %.3f  ATVR %.3f  (%zu transformed)\n", label, stats.Acmr, stats.Atvr, stats.Transformed);
+    }
+
+    void PrintThroughput(const LS::Test::Samples& samples, size_t triangles)
+    {
+        const auto p50 = samples.Percentile(0.5);
+        std::printf("  %.1f M triangles/s at p50\n", p50 > 0.0 ? static_cast<double>(triangles) / (p50 * 1000.0) : 0.0);
+    }
+
+    // Shuffled triangles stand in for an unordered import
+    auto Shuffled(std::vector<uint32_t> indices) -> std::vector<uint32_t>
+    {
+        LS::Test::Random random(3u);
+        for (size_t i = indices.size() / 3u - 1u; i > 0u; --i)
+        {
+            const auto j = random.Next(static_cast<uint32_t>(i + 1u));
+            std::swap_ranges(indices.begin() + i * 3u, indices.begin() + i * 3u + 3u, indices.begin() + j * 3u);
+        }
+        return indices;
+    }
+}
+
+LS_BENCHMARK(MeshProcessing_CreateTerrain3M)
+{
+    Mesh::MeshData terrain;
+    const auto samples = LS::Test::Measure(5u, [&]()
+        {
+            terrain = CreateTerrain();
+            LS::Test::DoNotOptimize(terrain.Indices.front());
+        });
+    std::printf("  %zu triangles, %zu vertices\n", terrain.TriangleCount(), terrain.Vertices.size());
+    LS::Test::Report("CreateTerrainLH", samples);
+    PrintThroughput(samples, terrain.TriangleCount());
+}
+
+LS_BENCHMARK(MeshProcessing_VertexCache3M)
+{
+    const auto terrain = CreateTerrain();
+    const auto vertexCount = terrain.Vertices.size();
+    std::printf("  %zu triangles, %zu vertices, %u entry FIFO\n", terrain.TriangleCount(), vertexCount, Mesh::DEFAULT_CACHE_SIZE);
+
+    PrintStats("row order (generator)", Mesh::AnalyzeVertexCache(terrain.Indices, vertexCount));
+
+    const auto shuffled = Shuffled(terrain.Indices);
+    PrintStats("shuffled (before)", Mesh::AnalyzeVertexCache(shuffled, vertexCount));
+
+    const auto analyze = LS::Test::Measure(5u, [&]()
+        {
+            LS::Test::DoNotOptimize(Mesh::AnalyzeVertexCache(shuffled, vertexCount));
+        });
+    LS::Test::Report("AnalyzeVertexCache", analyze);
+
+    // Each sample copies the shuffled buffer first so every run starts from the same order
+    std::vector<uint32_t> optimized;
+    const auto optimize = LS::Test::Measure(5u, [&]()
+        {
+            optimized = shuffled;
+            Mesh::OptimizeVertexCache(optimized, vertexCount);
+            LS::Test::DoNotOptimize(optimized.front());
+        });
+    LS::Test::Report("OptimizeVertexCache (shuffled input)", optimize);
+    PrintThroughput(optimize, terrain.TriangleCount());
+    PrintStats("shuffled, optimized (after)", Mesh::AnalyzeVertexCache(optimized, vertexCount));
+
+    auto rowOrder = terrain.Indices;
+    Mesh::OptimizeVertexCache(rowOrder, vertexCount);
+    PrintStats("row order, optimized", Mesh::AnalyzeVertexCache(rowOrder, vertexCount));
+}
+
+LS_BENCHMARK(MeshProcessing_Weld3M)
+{
+    const auto terrain = CreateTerrain();
+
+    // Separate streams indexed per corner, the way an OBJ import hands them over
+    std::vector<Vec3F> positions(terrain.Vertices.size());
+    std::vector<Vec3F> normals(terrain.Vertices.size());
+    std::vector<Vec2F> texCoords(terrain.Vertices.size());
+    for (size_t i = 0u; i < terrain.Vertices.size(); ++i)
+    {
+        positions[i] = terrain.Vertices[i].Position;
+        normals[i] = terrain.Vertices[i].Normal;
+        texCoords[i] = terrain.Vertices[i].TexCoord;
+    }
+
+    Mesh::MeshData welded;
+    const auto corners = LS::Test::Measure(5u, [&]()
+        {
+            welded = Mesh::WeldCorners(positions, normals, texCoords, terrain.Indices, terrain.Indices, terrain.Indices);
+            LS::Test::DoNotOptimize(welded.Vertices.front());
+        });
+    LS::Test::Report("WeldCorners", corners);
+    PrintThroughput(corners, terrain.TriangleCount());
+    std::printf("  %zu corners -> %zu vertices\n", terrain.Indices.size(), welded.Vertices.size());
+}
+
+LS_BENCHMARK(MeshProcessing_Quantize3M)
+{
+    const auto terrain = CreateTerrain();
+
+    Mesh::QuantizedMesh quantized;
+    const auto samples = LS::Test::Measure(5u, [&]()
+        {
+            quantized = Mesh::QuantizeVertices(terrain.Vertices);
+            LS::Test::DoNotOptimize(quantized.Vertices.front());
+        });
+    LS::Test::Report("QuantizeVertices", samples);
+    const auto p50 = samples.Percentile(0.5);
+    std::printf("  %.1f M vertices/s at p50, %zu -> %zu bytes\n",
+        p50 > 0.0 ? static_cast<double>(terrain.Vertices.size()) / (p50 * 1000.0) : 0.0,
+        terrain.Vertices.size() * sizeof(Mesh::MeshVertex), quantized.Vertices.size() * sizeof(Mesh::QuantizedVertex));
+}
+
+LS_BENCHMARK(MeshProcessing_Overdraw3M)
+{
+    const auto terrain = CreateTerrain();
+    const auto vertexCount = terrain.Vertices.size();
+    auto cacheOptimized = Shuffled(terrain.Indices);
+    Mesh::OptimizeVertexCache(cacheOptimized, vertexCount);
+    PrintStats("cache optimized (before)", Mesh::AnalyzeVertexCache(cacheOptimized, vertexCount));
+
+    std::vector<uint32_t> indices;
+    const auto samples = LS::Test::Measure(5u, [&]()
+        {
+            indices = cacheOptimized;
+            Mesh::OptimizeOverdraw(indices, terrain.Vertices);
+            LS::Test::DoNotOptimize(indices.front());
+        });
+    LS::Test::Report("OptimizeOverdraw", samples);
+    PrintThroughput(samples, terrain.TriangleCount());
+    PrintStats("overdraw optimized (after)", Mesh::AnalyzeVertexCache(indices, vertexCount));
+}
+
+LS_BENCHMARK(MeshProcessing_LodChain3M)
+{
+    auto terrain = CreateTerrain();
+    Mesh::OptimizeVertexCache(terrain.Indices, terrain.Vertices.size());
+    const auto triangles = terrain.TriangleCount();
+    const std::array<size_t, 4> targets{ triangles / 2u, triangles / 4u, triangles / 16u, triangles / 64u };
+
+    // A single sample, one chain is several seconds of work
+    std::vector<Mesh::MeshLod> lods;
+    const auto samples = LS::Test::Measure(1u, [&]()
+        {
+            lods = Mesh::BuildLodChain(terrain, targets);
+            LS::Test::DoNotOptimize(lods.front().Indices.front());
+        });
+    LS::Test::Report("BuildLodChain", samples);
+    PrintThroughput(samples, triangles);
+    for (const auto& lod : lods)
+    {
+        std::printf("  %9zu triangles  error %.4f\n", lod.Indices.size() / 3u, lod.Error);
+    }
+}
@@ -0,0 +1,162 @@
+#include "LSTest.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+import Engine.LSDevice;
+import Engine.PipelineCache;
+import Engine.Shader;
+import LSDataLib;
+import Util.StdUtils;
+
+namespace
+{
+    using namespace LS;
+
+    constexpr uint32_t LOOKUPS = 1'000'000u;
+
+    // Sizes typical of compiled vertex and pixel shader blobs
+    constexpr size_t VERTEX_SHADER_BYTES = 2u * 1024u;
+    constexpr size_t PIXEL_SHADER_BYTES = 6u * 1024u;
+
+    auto MakePipelines(uint32_t count) -> std::vector<PipelineDescriptor>
+    {
+        std::vector<PipelineDescriptor> pipelines(count);
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto& pipeline = pipelines[i];
+            pipeline.RasterizeState = RasterizerInfo{ .Fill = FILL_STATE::FILL, .Cull = static_cast<CULL_METHOD>(i % 3u) };
+            pipeline.BlendState.BlendType = static_cast<BlendType>(i % 4u);
+            pipeline.DepthStencil.IsDepthEnabled = true;
+            pipeline.DepthStencil.DepthBufferWriteAll = (i & 1u) == 0u;
+            pipeline.Shaders[SHADER_TYPE::VERTEX] = std::vector<std::byte>(VERTEX_SHADER_BYTES, static_cast<std::byte>(i / 8u));
+            pipeline.Shaders[SHADER_TYPE::PIXEL] = std::vector<std::byte>(PIXEL_SHADER_BYTES, static_cast<std::byte>(i));
+            pipeline.ShaderSignature.AddElement(ShaderElement{ .SemanticName = "POSITION" });
+            pipeline.ShaderSignature.AddElement(ShaderElement{ .SemanticName = "NORMAL", .OffsetAligned = 12u });
+            pipeline.ShaderSignature.AddElement(ShaderElement{ .SemanticName = "TEXCOORD", .OffsetAligned = 24u });
+            pipeline.Topology = PRIMITIVE_TOPOLOGY::TRIANGLE_LIST;
+            pipeline.RenderTarget.PixelFormat = PIXEL_COLOR_FORMAT::RGBA8_UNORM;
+            pipeline.RenderTarget.SampleCount = 1u;
+            pipeline.Samplers.push_back(SamplerMap{ .BindSlot = 0u, .Sampler = LSSamplerState{ .AnisotropyLevel = i % 8u } });
+        }
+        return pipelines;
+    }
+
+    /**
+     * @brief What renderers did before the cache: bucket by the old LSDrawStateHashFunc, an XOR of the rasterizer
+     * fields, and deep compare every descriptor in the bucket
+     */
+    class BaselineCache
+    {
+    public:
+        auto Intern(const PipelineDescriptor& pipeline) -> StateHandle
+        {
+            auto& bucket = m_buckets[XorHash(pipeline.RasterizeState)];
+            for (const auto& [stored, handle] : bucket)
+            {
+                if (IsSame(stored, pipeline))
+                    return handle;
+            }
+            bucket.emplace_back(pipeline, m_next);
+            return m_next++;
+        }
+
+    private:
+        static auto XorHash(const RasterizerInfo& t) noexcept -> size_t
+        {
+            const size_t h1 = LS::Utils::HashEnum(t.Fill);
+            const size_t h2 = t.IsFrontCounterClockwise ? 1 : 0;
+            const size_t h3 = LS::Utils::HashEnum(t.Cull);
+            const size_t h4 = t.IsDepthClipEnabled ? 1 : 0;
+            return h1 ^ h2 ^ h3 ^ h4;
+        }
+
+        static auto IsSame(const PipelineDescriptor& a, const PipelineDescriptor& b) -> bool
+        {
+            return a.RasterizeState == b.RasterizeState
+                && a.BlendState == b.BlendState
+                && a.DepthStencil == b.DepthStencil
+                && a.Topology == b.Topology
+                && a.RenderTarget.PixelFormat == b.RenderTarget.PixelFormat
+                && a.RenderTarget.SampleCount == b.RenderTarget.SampleCount
+                && a.RenderTarget.SampleQuality == b.RenderTarget.SampleQuality
+                && a.Samplers == b.Samplers
+                && a.ShaderSignature == b.ShaderSignature
+                && a.Shaders == b.Shaders;
+        }
+
+        std::unordered_map<size_t, std::vector<std::pair<PipelineDescriptor, StateHandle>>> m_buckets;
+        StateHandle m_next = 0u;
+    };
+
+    /**
+     * @brief 1M lookups over @p pipelines, which are already in @p cache
+     */
+    template<class Cache>
+    auto MeasureHits(Cache& cache, const std::vector<PipelineDescriptor>& pipelines) -> LS::Test::Samples
+    {
+        const auto distinct = static_cast<uint32_t>(pipelines.size());
+        return LS::Test::Measure(3u, [&]()
+            {
+                StateHandle sum = 0u;
+                for (auto i = 0u; i < LOOKUPS; ++i)
+                    sum += cache.Intern(pipelines[(i * 7u) % distinct]);
+                LS::Test::DoNotOptimize(sum);
+            });
+    }
+}
+
+LS_BENCHMARK(PipelineCache_MillionLookups)
+{
+    for (const auto distinct : { 16u, 256u })
+    {
+        auto pipelines = MakePipelines(distinct);
+        char name[96];
+
+        BaselineCache baseline;
+        for (const auto& pipeline : pipelines)
+            LS::Test::DoNotOptimize(baseline.Intern(pipeline));
+        const auto baselineSamples = MeasureHits(baseline, pipelines);
+        std::snprintf(name, sizeof(name), "1M baseline hits over %u pipelines (XOR hash + deep compare)", distinct);
+        LS::Test::Report(name, baselineSamples);
+
+        PipelineCache blobCache;
+        for (const auto& pipeline : pipelines)
+            LS::Test::DoNotOptimize(blobCache.Intern(pipeline));
+        const auto blobSamples = MeasureHits(blobCache, pipelines);
+        std::snprintf(name, sizeof(name), "1M Intern hits over %u pipelines (shader blobs)", distinct);
+        LS::Test::Report(name, blobSamples);
+
+        // Shaders interned once when they are created, the descriptor carries the handle
+        PipelineCache cache;
+        for (auto& pipeline : pipelines)
+        {
+            pipeline.ShaderSet = cache.InternShaders(pipeline.Shaders);
+            LS::Test::DoNotOptimize(cache.Intern(pipeline));
+        }
+        cache.ResetStats();
+        const auto samples = MeasureHits(cache, pipelines);
+        std::snprintf(name, sizeof(name), "1M Intern hits over %u pipelines (ShaderSet)", distinct);
+        LS::Test::Report(name, samples);
+
+        const auto stats = cache.GetStats();
+        std::printf("  hit rate %.4f, average lookup %.1f ns, %u pipelines, %.1fx faster than baseline\n",
+            stats.Pipelines.HitRate(), stats.Pipelines.AverageLookupNs(), stats.PipelineCount,
+            baselineSamples.Percentile(0.5) / samples.Percentile(0.5));
+    }
+}
+
+LS_BENCHMARK(PipelineCache_MissPath)
+{
+    const auto pipelines = MakePipelines(4096u);
+    const auto samples = LS::Test::Measure(5u, [&]()
+        {
+            PipelineCache cache;
+            for (const auto& pipeline : pipelines)
+                LS::Test::DoNotOptimize(cache.Intern(pipeline));
+        });
+    LS::Test::Report("4096 Intern misses into an empty cache", samples);
+}
@@ -0,0 +1,37 @@
+#include "LSTest.h"
+#include <cstdint>
+
+#define LS_ENABLE_PROFILE 1
+#include "engine/EngineProfileDefines.h"
+
+namespace
+{
+    constexpr uint32_t ZONES = 1'000'000u;
+
+    void MeasureZones(const char* name)
+    {
+        const auto samples = LS::Test::Measure(10u, []()
+            {
+                uint64_t sum = 0u;
+                for (auto i = 0u; i < ZONES; ++i)
+                {
+                    LS_PROFILE_ZONE("Bench");
+                    sum += i;
+                }
+                LS::Test::DoNotOptimize(sum);
+            });
+        LS::Test::Report(name, samples);
+    }
+}
+
+LS_BENCHMARK(Profiler_ZoneOverhead)
+{
+    LS::Profile::Reset();
+    LS::Profile::SetEnabled(false);
+    MeasureZones("1M zones (disabled)");
+
+    LS::Profile::SetEnabled(true);
+    MeasureZones("1M zones (enabled)");
+    LS::Profile::SetEnabled(false);
+    LS::Profile::Reset();
+}
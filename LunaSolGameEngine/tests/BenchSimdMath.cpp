@@ -0,0 +1,90 @@
+#include "LSTest.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+import LSDataLib;
+import MathLib;
+
+namespace
+{
+    using namespace LS;
+    using namespace LS::Math;
+
+    constexpr const char* LEVEL_NAMES[] = { "scalar", "sse2", "avx2" };
+
+    auto MakeMatrices(size_t count) -> std::vector<Mat4F>
+    {
+        std::vector<Mat4F> matrices(count);
+        LS::Test::Random random(1u);
+        for (auto& m : matrices)
+        {
+            for (auto i = 0u; i < 16u; ++i)
+                m.Mat[i] = random.NextFloat() + (i % 5u == 0u ? 2.0f : 0.0f);
+        }
+        return matrices;
+    }
+
+    template <class Func>
+    void ForEachSimdLevel(Func&& func)
+    {
+        const auto detected = GetSimdLevel();
+        for (auto level = static_cast<uint8_t>(SIMD_LEVEL::SCALAR); level <= static_cast<uint8_t>(detected); ++level)
+        {
+            SetSimdLevel(static_cast<SIMD_LEVEL>(level));
+            func(LEVEL_NAMES[level]);
+        }
+        SetSimdLevel(detected);
+    }
+}
+
+LS_BENCHMARK(SimdMath_MatrixKernels)
+{
+    constexpr size_t COUNT = 1u << 16;
+    const auto matrices = MakeMatrices(COUNT);
+    std::printf("  %zu matrices, detected level: %s\n", COUNT, LEVEL_NAMES[static_cast<uint8_t>(GetSimdLevel())]);
+
+    ForEachSimdLevel([&](const char* level)
+        {
+            const auto multiply = LS::Test::Measure(20u, [&]()
+                {
+                    Mat4F acc = Mat4F::Identity();
+                    for (auto i = 0u; i + 1u < COUNT; i += 2u)
+                        acc = Multiply(matrices[i], matrices[i + 1u]);
+                    LS::Test::DoNotOptimize(acc);
+                });
+            LS::Test::Report(std::string("Multiply x32k (") + level + ")", multiply);
+
+            const auto inverse = LS::Test::Measure(20u, [&]()
+                {
+                    float sum = 0.0f;
+                    for (const auto& m : matrices)
+                        sum += Inverse(m).value_or(m).Mat[0];
+                    LS::Test::DoNotOptimize(sum);
+                });
+            LS::Test::Report(std::string("Inverse x64k (") + level + ")", inverse);
+        });
+}
+
+LS_BENCHMARK(SimdMath_BatchTransforms)
+{
+    constexpr size_t COUNT = 1u << 20;
+    const auto m = MakeMatrices(1u).front();
+    std::vector<Vec3F> points(COUNT, Vec3F{ .x = 1.0f, .y = 2.0f, .z = 3.0f });
+    std::vector<Vec4F> vectors(COUNT, Vec4F{ .x = 1.0f, .y = 2.0f, .z = 3.0f, .w = 1.0f });
+    const auto stream = Vec3Stream::FromVectors(points);
+    std::vector<Vec3F> outPoints(COUNT);
+    std::vector<Vec4F> outVectors(COUNT);
+    Vec3Stream outStream;
+
+    ForEachSimdLevel([&](const char* level)
+        {
+            LS::Test::Report(std::string("TransformPoints 1M Vec3F (") + level + ")",
+                LS::Test::Measure(20u, [&]() { TransformPoints(m, points, outPoints); LS::Test::DoNotOptimize(outPoints); }));
+            LS::Test::Report(std::string("Transform 1M Vec4F (") + level + ")",
+                LS::Test::Measure(20u, [&]() { Transform(m, vectors, outVectors); LS::Test::DoNotOptimize(outVectors); }));
+            LS::Test::Report(std::string("TransformPoints 1M Vec3Stream (") + level + ")",
+                LS::Test::Measure(20u, [&]() { TransformPoints(m, stream, outStream); LS::Test::DoNotOptimize(outStream); }));
+        });
+}
@@ -0,0 +1,173 @@
+#include "LSTest.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+import LSE.Serialize.WavefrontObj;
+
+namespace
+{
+    // Quads per side: 1M and 10M faces, 50M (a ~5 GB file) only when configured with LS_BENCHMARK_50M_FACES
+#ifdef LS_BENCHMARK_50M_FACES
+    constexpr uint32_t GRID_SIZES[] = { 1000u, 3163u, 7072u };
+#else
+    constexpr uint32_t GRID_SIZES[] = { 1000u, 3163u };
+#endif
+
+    // A grid of quads with texture coordinates and normals, roughly 1 KiB per 10 quads
+    auto WriteGridObj(const std::filesystem::path& path, uint32_t size) -> void
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::string buffer;
+        const auto flush = [&](bool force)
+            {
+                if (force || buffer.size() > (8u << 20u))
+                {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            };
+
+        for (auto z = 0u; z <= size; ++z)
+        {
+            for (auto x = 0u; x <= size; ++x)
+            {
+                std::format_to(std::back_inserter(buffer), "v {} {} {}\nvt {} {}\n", x * 0.5f, (x ^ z) * 0.01f, z * 0.5f,
+                    x / static_cast<float>(size), z / static_cast<float>(size));
+            }
+            flush(false);
+        }
+        buffer += "vn 0 1 0\n";
+        const auto stride = size + 1u;
+        for (auto z = 0u; z < size; ++z)
+        {
+            for (auto x = 0u; x < size; ++x)
+            {
+                const auto i = z * stride + x + 1u;
+                std::format_to(std::back_inserter(buffer), "f {0}/{0}/1 {1}/{1}/1 {2}/{2}/1 {3}/{3}/1\n", i, i + stride, i + stride + 1u, i + 1u);
+            }
+            flush(false);
+        }
+        flush(true);
+    }
+
+    /**
+     * @brief Peak resident memory in bytes while running @p func once, or 0 if it could not be measured.
+     * POSIX runs @p func in a forked child so every path starts from the same baseline and running out of memory
+     * only kills the child. Windows has no fork and reports this process's peak so far, so measure the path
+     * expected to use the least memory first.
+     */
+    template<class Func>
+    auto PeakResidentBytes(Func&& func) -> size_t
+    {
+#ifdef _WIN32
+        func();
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0u;
+        return counters.PeakWorkingSetSize;
+#else
+        int fds[2];
+        if (pipe(fds) != 0)
+            return 0u;
+
+        const auto child = fork();
+        if (child == 0)
+        {
+            close(fds[0]);
+            func();
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            // ru_maxrss is in KiB on Linux
+            const auto peak = static_cast<size_t>(usage.ru_maxrss) * 1024u;
+            [[maybe_unused]] const auto written = write(fds[1], &peak, sizeof(peak));
+            _exit(0);
+        }
+
+        close(fds[1]);
+        size_t peak = 0u;
+        if (child > 0)
+        {
+            if (read(fds[0], &peak, sizeof(peak)) != static_cast<ssize_t>(sizeof(peak)))
+                peak = 0u;
+            waitpid(child, nullptr, 0);
+        }
+        close(fds[0]);
+        return peak;
+#endif
+    }
+
+    void ReportThroughput(std::string_view name, const LS::Test::Samples& samples, uintmax_t fileBytes)
+    {
+        LS::Test::Report(name, samples);
+        const auto seconds = samples.Percentile(0.5) / 1000.0;
+        std::printf("  %-48s %10.1f MB/s at p50\n", "",
+            seconds > 0.0 ? static_cast<double>(fileBytes) / (seconds * 1e6) : 0.0);
+    }
+
+    void LoadLegacy(const std::filesystem::path& path)
+    {
+        LS::Serialize::WavefrontObj obj;
+        [[maybe_unused]] auto loaded = obj.LoadFile(path);
+        [[maybe_unused]] auto parsed = obj.LoadObject();
+        LS::Test::DoNotOptimize(obj);
+    }
+
+    void LoadStreamed(const std::filesystem::path& path, uint32_t threads)
+    {
+        LS::Serialize::WavefrontObj obj;
+        [[maybe_unused]] auto loaded = obj.LoadStreamed(path, threads);
+        LS::Test::DoNotOptimize(obj);
+    }
+}
+
+LS_BENCHMARK(WavefrontObj_LoadStreamedVsLoadObject)
+{
+    const LS::Test::TempDir dir("ls_bench_wavefront_obj");
+    const auto path = dir / "grid.obj";
+    for (const auto size : GRID_SIZES)
+    {
+        const auto faces = static_cast<uint64_t>(size) * size;
+        WriteGridObj(path, size);
+        const auto fileBytes = std::filesystem::file_size(path);
+        std::printf("  %llu faces: %.1f MiB\n", static_cast<unsigned long long>(faces), fileBytes / (1024.0 * 1024.0));
+
+        // Smallest expected footprint first, which keeps the in-process Windows peak meaningful
+        const auto streamedPeak = PeakResidentBytes([&]() { LoadStreamed(path, 0u); });
+        const auto legacyPeak = PeakResidentBytes([&]() { LoadLegacy(path); });
+        std::printf("  peak RSS: LoadStreamed %.1f MiB, LoadFile + LoadObject %.1f MiB\n",
+            streamedPeak / (1024.0 * 1024.0), legacyPeak / (1024.0 * 1024.0));
+
+        // Large files take seconds per load, one sample after the warm up run is enough
+        const auto iterations = faces > 2'000'000u ? 1u : 3u;
+        if (legacyPeak > 0u)
+        {
+            ReportThroughput("LoadFile + LoadObject", LS::Test::Measure(iterations, [&]() { LoadLegacy(path); }), fileBytes);
+        }
+        else
+        {
+            std::printf("  LoadFile + LoadObject did not finish in the child process, skipping its timing\n");
+        }
+
+        for (const auto threads : { 1u, 2u, 4u, 0u })
+        {
+            ReportThroughput(std::format("LoadStreamed ({} threads)", threads),
+                LS::Test::Measure(iterations, [&]() { LoadStreamed(path, threads); }), fileBytes);
+        }
+    }
+}
@@ -0,0 +1,224 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+/**
+ * @brief A minimal test and benchmark registry for the engine's test targets.
+ * LS_TEST cases are run by LunaSolTests and LS_BENCHMARK cases by LunaSolBenchmarks, both accept a name filter as their first argument.
+ */
+namespace LS::Test
+{
+    using TestFunc = void(*)();
+
+    struct TestCase
+    {
+        const char* Name;
+        TestFunc Func;
+    };
+
+    inline auto GetTests() -> std::vector<TestCase>&
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    inline auto GetBenchmarks() -> std::vector<TestCase>&
+    {
+        static std::vector<TestCase> benchmarks;
+        return benchmarks;
+    }
+
+    inline auto FailureCount() -> uint32_t&
+    {
+        static uint32_t failures = 0u;
+        return failures;
+    }
+
+    struct Registrar
+    {
+        Registrar(std::vector<TestCase>& list, const char* name, TestFunc func)
+        {
+            list.emplace_back(TestCase{ .Name = name, .Func = func });
+        }
+    };
+
+    inline auto Check(bool passed, const char* expr, const char* file, int line) -> bool
+    {
+        if (!passed)
+        {
+            ++FailureCount();
+            std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expr);
+        }
+        return passed;
+    }
+
+    /**
+     * @brief Runs every case whose name contains the filter, returns the number of cases that failed
+     */
+    inline auto RunAll(const std::vector<TestCase>& cases, std::string_view filter) -> int
+    {
+        int failed = 0;
+        for (const auto& test : cases)
+        {
+            if (std::string_view(test.Name).find(filter) == std::string_view::npos)
+                continue;
+
+            const auto before = FailureCount();
+            std::printf("[ RUN  ] %s\n", test.Name);
+            test.Func();
+            const auto passed = FailureCount() == before;
+            failed += passed ? 0 : 1;
+            std::printf("[ %s ] %s\n", passed ? " OK " : "FAIL", test.Name);
+        }
+        std::printf("%d case(s) failed\n", failed);
+        return failed;
+    }
+
+    /**
+     * @brief Keeps the compiler from discarding a benchmarked result
+     */
+    template <class T>
+    inline void DoNotOptimize(const T& value)
+    {
+        static volatile const void* sink;
+        sink = &value;
+    }
+
+    /**
+     * @brief Sorted sample timings in milliseconds
+     */
+    struct Samples
+    {
+        std::vector<double> Ms;
+
+        auto Percentile(double p) const -> double
+        {
+            if (Ms.empty())
+                return 0.0;
+            const auto index = static_cast<size_t>(p * static_cast<double>(Ms.size() - 1) + 0.5);
+            return Ms[std::min(index, Ms.size() - 1)];
+        }
+    };
+
+    /**
+     * @brief Times func over the given number of iterations after one warm up run
+     */
+    template <class Func>
+    auto Measure(uint32_t iterations, Func&& func) -> Samples
+    {
+        using Clock = std::chrono::steady_clock;
+        func();
+
+        Samples samples;
+        samples.Ms.reserve(iterations);
+        for (auto i = 0u; i < iterations; ++i)
+        {
+            const auto start = Clock::now();
+            func();
+            samples.Ms.emplace_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::sort(samples.Ms.begin(), samples.Ms.end());
+        return samples;
+    }
+
+    inline void Report(std::string_view name, const Samples& samples)
+    {
+        std::printf("  %-48.*s min %10.3f ms  p50 %10.3f ms  p99 %10.3f ms\n",
+            static_cast<int>(name.size()), name.data(), samples.Percentile(0.0), samples.Percentile(0.5), samples.Percentile(0.99));
+    }
+
+    /**
+     * @brief Small LCG so generated data is identical on every platform and failures reproduce
+     */
+    struct Random
+    {
+        uint32_t State;
+
+        explicit Random(uint32_t seed = 12345u) : State(seed)
+        {
+        }
+
+        auto Next() -> uint32_t
+        {
+            State = State * 1664525u + 1013904223u;
+            return State;
+        }
+
+        /**
+         * @return A value in [0, bound) from the better mixed high bits
+         */
+        auto Next(uint32_t bound) -> uint32_t
+        {
+            return (Next() >> 8) % bound;
+        }
+
+        /**
+         * @return A value in [0, 1)
+         */
+        auto NextFloat() -> float
+        {
+            return static_cast<float>(Next() >> 8) / static_cast<float>(1u << 24);
+        }
+    };
+
+    /**
+     * @brief A fresh directory under the system temp directory, removed with its contents when it goes out of scope
+     */
+    class TempDir
+    {
+    public:
+        explicit TempDir(std::string_view name)
+            : m_path(std::filesystem::temp_directory_path() / name)
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(m_path, ec);
+            std::filesystem::create_directories(m_path);
+        }
+
+        TempDir(const TempDir&) = delete;
+        TempDir& operator=(const TempDir&) = delete;
+
+        ~TempDir()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(m_path, ec);
+        }
+
+        [[nodiscard]] auto Path() const noexcept -> const std::filesystem::path&
+        {
+            return m_path;
+        }
+
+        [[nodiscard]] auto operator/(std::string_view file) const -> std::filesystem::path
+        {
+            return m_path / file;
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+}
+
+#define LS_TEST_CONCAT_IMPL(a, b) a##b
+#define LS_TEST_CONCAT(a, b) LS_TEST_CONCAT_IMPL(a, b)
+
+#define LS_TEST(name) \
+    static void name(); \
+    static const LS::Test::Registrar LS_TEST_CONCAT(name, _registrar)(LS::Test::GetTests(), #name, &name); \
+    static void name()
+
+#define LS_BENCHMARK(name) \
+    static void name(); \
+    static const LS::Test::Registrar LS_TEST_CONCAT(name, _registrar)(LS::Test::GetBenchmarks(), #name, &name); \
+    static void name()
+
+// Records a failure and continues
+#define LS_CHECK(expr) LS::Test::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+// Records a failure and leaves the test
+#define LS_REQUIRE(expr) do { if (!LS_CHECK(expr)) return; } while (false)
@@ -0,0 +1,177 @@
+#include "LSTest.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+import Helper.AsyncIO;
+
+namespace
+{
+    namespace fs = std::filesystem;
+    using namespace LS::IO;
+
+    /**
+     * @brief A directory of files with known contents, removed when the test ends
+     */
+    struct TempFiles
+    {
+        LS::Test::TempDir Dir{ "ls_test_async_io" };
+        std::vector<fs::path> Paths;
+        std::vector<std::vector<std::byte>> Contents;
+
+        explicit TempFiles(uint32_t count)
+        {
+            LS::Test::Random random(99u);
+            for (auto i = 0u; i < count; ++i)
+            {
+                const auto value = random.Next();
+                // Mostly small files, an empty one and a few large enough to need several reads
+                const size_t size = i == 3u ? 0u : (i % 25u == 0u ? (1u << 20) + value % 4096u : value % 20000u);
+                std::vector<std::byte> bytes(size);
+                for (auto& b : bytes)
+                    b = static_cast<std::byte>(random.Next() >> 24);
+
+                auto path = Dir / ("file" + std::to_string(i) + ".bin");
+                std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(size));
+                Paths.emplace_back(std::move(path));
+                Contents.emplace_back(std::move(bytes));
+            }
+        }
+
+        [[nodiscard]] auto Requests() const -> std::vector<ReadRequest>
+        {
+            std::vector<ReadRequest> requests;
+            for (const auto& path : Paths)
+                requests.push_back(ReadRequest{ .Path = path });
+            return requests;
+        }
+
+        [[nodiscard]] auto Matches(uint32_t index, const ReadResult& result) const -> bool
+        {
+            const auto& expected = Contents[index];
+            return result.Result && result.Index == index && result.Data.size() == expected.size()
+                && (expected.empty() || std::memcmp(result.Data.data(), expected.data(), expected.size()) == 0);
+        }
+    };
+
+    auto CountMismatches(const TempFiles& files, std::vector<std::future<ReadResult>>& futures) -> uint32_t
+    {
+        auto mismatches = 0u;
+        for (auto i = 0u; i < futures.size(); ++i)
+            mismatches += !files.Matches(i, futures[i].get());
+        return mismatches;
+    }
+}
+
+LS_TEST(AsyncIO_BatchReadsMatchFiles)
+{
+    const TempFiles files(200u);
+    for (const auto backend : { IO_BACKEND::THREAD_POOL, IO_BACKEND::IO_URING })
+    {
+        AsyncIO io(AsyncIOSettings{ .Backend = backend, .QueueDepth = 16u });
+        auto futures = io.ReadBatch(files.Requests());
+        LS_CHECK(CountMismatches(files, futures) == 0u);
+
+        const auto stats = io.GetStats();
+        LS_CHECK(stats.Requests == 200u);
+        LS_CHECK(stats.Failures == 0u);
+    }
+}
+
+LS_TEST(AsyncIO_AutoUsesThreadPool)
+{
+    AsyncIO io;
+    LS_CHECK(io.GetBackend() == IO_BACKEND::THREAD_POOL);
+}
+
+LS_TEST(AsyncIO_RangedReadsAndErrors)
+{
+    const TempFiles files(30u);
+    AsyncIO io(AsyncIOSettings{ .QueueDepth = 4u });
+
+    std::vector<std::byte> destination(100u);
+    auto ranged = io.Read(ReadRequest{ .Path = files.Paths[0], .Offset = 1000u, .Length = 100u, .Destination = destination });
+    auto mapped = io.Read(ReadRequest{ .Path = files.Paths[0], .Offset = 5u, .Length = 64u, .Mode = READ_MODE::MAPPED });
+    auto missing = io.Read(ReadRequest{ .Path = files.Dir / "missing.bin" });
+    auto pastEnd = io.Read(ReadRequest{ .Path = files.Paths[1], .Offset = files.Contents[1].size(), .Length = 1u });
+
+    const auto rangedResult = ranged.get();
+    LS_CHECK(rangedResult.Result && rangedResult.Data.data() == destination.data());
+    LS_CHECK(std::memcmp(destination.data(), files.Contents[0].data() + 1000u, 100u) == 0);
+
+    const auto mappedResult = mapped.get();
+    LS_CHECK(mappedResult.Result && mappedResult.Data.size() == 64u);
+    LS_CHECK(std::memcmp(mappedResult.Data.data(), files.Contents[0].data() + 5u, 64u) == 0);
+
+    LS_CHECK(!missing.get().Result);
+    LS_CHECK(!pastEnd.get().Result);
+    LS_CHECK(io.GetStats().Failures == 2u);
+}
+
+LS_TEST(AsyncIO_UringSubmitFailureFallsBackToThreadPool)
+{
+    const TempFiles files(200u);
+    for (const auto failImmediately : { true, false })
+    {
+        AsyncIO io(AsyncIOSettings{ .Backend = IO_BACKEND::IO_URING, .QueueDepth = 8u });
+        if (io.GetBackend() != IO_BACKEND::IO_URING)
+            return;
+
+        // Failing the first submission discards reads the kernel never saw, failing a later one also has to
+        // drain the reads already in flight
+        if (failImmediately)
+            Detail::FailNextUringSubmit.store(true);
+        auto futures = io.ReadBatch(files.Requests());
+        if (!failImmediately)
+            Detail::FailNextUringSubmit.store(true);
+
+        LS_CHECK(CountMismatches(files, futures) == 0u);
+        io.WaitIdle();
+        LS_CHECK(io.GetStats().Failures == 0u);
+
+        // The rest of the object's life uses the thread pool
+        if (!Detail::FailNextUringSubmit.exchange(false))
+        {
+            LS_CHECK(io.GetBackend() == IO_BACKEND::THREAD_POOL);
+            auto again = io.ReadBatch(files.Requests());
+            LS_CHECK(CountMismatches(files, again) == 0u);
+        }
+    }
+}
+
+LS_TEST(AsyncIO_UringFallbackStartsEveryPoolThread)
+{
+    constexpr uint32_t THREAD_COUNT = 3u;
+    const TempFiles files(THREAD_COUNT);
+    AsyncIO io(AsyncIOSettings{ .Backend = IO_BACKEND::IO_URING, .ThreadCount = THREAD_COUNT, .QueueDepth = 8u });
+    if (io.GetBackend() != IO_BACKEND::IO_URING)
+        return;
+
+    Detail::FailNextUringSubmit.store(true);
+    auto first = io.Read(ReadRequest{ .Path = files.Paths[0] });
+    LS_REQUIRE(first.get().Result);
+    LS_REQUIRE(io.GetBackend() == IO_BACKEND::THREAD_POOL);
+
+    // Each callback holds its thread until every read has started, which only finishes with THREAD_COUNT threads
+    std::mutex lock;
+    std::condition_variable signal;
+    uint32_t started = 0u;
+    uint32_t met = 0u;
+    io.ReadBatch(files.Requests(), [&](ReadResult&&)
+        {
+            std::unique_lock guard(lock);
+            ++started;
+            signal.notify_all();
+            met += signal.wait_for(guard, std::chrono::seconds(5), [&] { return started == THREAD_COUNT; }) ? 1u : 0u;
+        });
+    io.WaitIdle();
+    LS_CHECK(met == THREAD_COUNT);
+}
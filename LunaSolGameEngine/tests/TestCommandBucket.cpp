@@ -0,0 +1,240 @@
+#include "LSTest.h"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+import Engine.CommandBucket;
+import Engine.LSDevice;
+
+namespace
+{
+    using namespace LS;
+
+    struct TestDraw
+    {
+        uint8_t Layer = 0u;
+        uint32_t Depth = 0u;
+        StateHandle Pipeline = 0u;
+        uint32_t Material = 0u;
+    };
+
+    auto MakeTestDraws(uint32_t count) -> std::vector<TestDraw>
+    {
+        LS::Test::Random random;
+        std::vector<TestDraw> draws(count);
+        for (auto& draw : draws)
+        {
+            draw.Layer = static_cast<uint8_t>(random.Next(3u));
+            draw.Pipeline = random.Next(64u);
+            draw.Material = random.Next(512u);
+            draw.Depth = QuantizeDepth(static_cast<float>(random.Next(1000u)) / 1000.0f);
+        }
+        return draws;
+    }
+
+    /**
+     * @brief Records draws[first, last) into @p buffer, tagging each packet with its draw index as the geometry
+     */
+    void RecordSlice(CommandBuffer& buffer, const std::vector<TestDraw>& draws, size_t first, size_t last)
+    {
+        for (auto i = first; i < last; ++i)
+        {
+            const auto& draw = draws[i];
+            buffer.DrawIndexed(draw.Layer, draw.Depth, draw.Pipeline, draw.Material, static_cast<uint32_t>(i), 36u);
+        }
+    }
+}
+
+LS_TEST(CommandBucket_SortKeyFieldOrder)
+{
+    // Layer outranks pipeline, which outranks material, which outranks depth
+    LS_CHECK(MakeSortKey(1u, 0u, 0u, 0u) > MakeSortKey(0u, 0xFFFFu, 0xFFFFu, QuantizeDepth(1.0f)));
+    LS_CHECK(MakeSortKey(0u, 1u, 0u, 0u) > MakeSortKey(0u, 0u, 0xFFFFu, QuantizeDepth(1.0f)));
+    LS_CHECK(MakeSortKey(0u, 0u, 1u, 0u) > MakeSortKey(0u, 0u, 0u, QuantizeDepth(1.0f)));
+
+    // Handles too large for their field clamp to its maximum instead of wrapping or spilling into the next field
+    LS_CHECK(MakeSortKey(0u, 0x1'0000u, 0u, 0u) == MakeSortKey(0u, 0xFFFFu, 0u, 0u));
+    LS_CHECK(MakeSortKey(0u, 0x1'0001u, 0u, 0u) > MakeSortKey(0u, 0xFFFEu, 0xFFFFu, QuantizeDepth(1.0f)));
+    LS_CHECK(MakeSortKey(0u, 1u, 0x1'0000u, 0u) < MakeSortKey(0u, 2u, 0u, 0u));
+    LS_CHECK(MakeSortKey(0u, INVALID_STATE_HANDLE, 0u, 0u) < MakeSortKey(1u, 0u, 0u, 0u));
+
+    LS_CHECK(QuantizeDepth(0.0f) == 0u);
+    LS_CHECK(QuantizeDepth(1.0f) == (1u << SORT_KEY_DEPTH_BITS) - 1u);
+    LS_CHECK(QuantizeDepth(2.0f) == QuantizeDepth(1.0f));
+    LS_CHECK(QuantizeDepth(0.25f) < QuantizeDepth(0.75f));
+    LS_CHECK(QuantizeDepth(0.25f, true) > QuantizeDepth(0.75f, true));
+}
+
+LS_TEST(CommandBucket_SortsAcrossBuffers)
+{
+    CommandBucket bucket(3u);
+    constexpr uint32_t DRAWS_PER_BUFFER = CommandBuffer::BLOCK_SIZE + 123u;
+    const auto draws = MakeTestDraws(3u * DRAWS_PER_BUFFER);
+    for (auto b = 0u; b < bucket.GetBufferCount(); ++b)
+        RecordSlice(bucket.GetBuffer(b), draws, b * DRAWS_PER_BUFFER, (b + 1u) * DRAWS_PER_BUFFER);
+
+    LS_CHECK(bucket.Size() == 3u * DRAWS_PER_BUFFER);
+    bucket.Sort();
+
+    auto unsorted = 0u;
+    auto mismatched = 0u;
+    for (auto i = 0u; i < bucket.Size(); ++i)
+    {
+        const auto& packet = bucket.GetSorted(i);
+        const auto& draw = draws[packet.Geometry];
+        mismatched += packet.Key != MakeSortKey(draw.Layer, draw.Pipeline, draw.Material, draw.Depth);
+        if (i > 0u)
+            unsorted += bucket.GetSorted(i - 1u).Key > packet.Key;
+    }
+    LS_CHECK(unsorted == 0u);
+    LS_CHECK(mismatched == 0u);
+}
+
+LS_TEST(CommandBucket_ParallelRecordingMatchesSerial)
+{
+    constexpr uint32_t THREADS = 4u;
+    const auto draws = MakeTestDraws(3u * CommandBuffer::BLOCK_SIZE + 77u);
+
+    CommandBucket serial(1u);
+    RecordSlice(serial.GetBuffer(0u), draws, 0u, draws.size());
+    serial.Sort();
+
+    // One buffer per thread, each recording a contiguous slice of the scene
+    CommandBucket parallel(THREADS);
+    {
+        const auto slice = (draws.size() + THREADS - 1u) / THREADS;
+        std::vector<std::jthread> threads;
+        for (auto t = 0u; t < THREADS; ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    const auto first = std::min(draws.size(), t * slice);
+                    RecordSlice(parallel.GetBuffer(t), draws, first, std::min(draws.size(), first + slice));
+                });
+        }
+    }
+    parallel.Sort();
+
+    LS_REQUIRE(parallel.Size() == serial.Size());
+    auto different = 0u;
+    for (auto i = 0u; i < serial.Size(); ++i)
+    {
+        const auto& expected = serial.GetSorted(i);
+        const auto& actual = parallel.GetSorted(i);
+        different += actual.Key != expected.Key || actual.Geometry != expected.Geometry
+            || actual.Pipeline != expected.Pipeline || actual.Material != expected.Material;
+    }
+    LS_CHECK(different == 0u);
+}
+
+LS_TEST(CommandBucket_EqualKeysKeepRecordingOrder)
+{
+    CommandBucket bucket(3u);
+    const auto key = MakeSortKey(0u, 7u, 3u, QuantizeDepth(0.5f));
+    const auto earlier = MakeSortKey(0u, 7u, 2u, 0u);
+
+    // Geometry tags each packet with its buffer and position; buffers merge in index order
+    for (auto b = 0u; b < bucket.GetBufferCount(); ++b)
+    {
+        for (auto i = 0u; i < 100u; ++i)
+        {
+            if (i % 2u == 0u)
+                bucket.GetBuffer(b).Draw(0u, QuantizeDepth(0.5f), 7u, 3u, b * 1000u + i, 3u);
+            else
+                bucket.GetBuffer(b).Draw(0u, 0u, 7u, 2u, b * 1000u + i, 3u);
+        }
+    }
+    bucket.Sort();
+
+    auto previous = -1;
+    auto inOrder = true;
+    for (auto i = 0u; i < bucket.Size(); ++i)
+    {
+        const auto& packet = bucket.GetSorted(i);
+        if (i == 150u)
+        {
+            LS_CHECK(packet.Key == key);
+            previous = -1;
+        }
+        inOrder = inOrder && static_cast<int>(packet.Geometry) > previous;
+        previous = static_cast<int>(packet.Geometry);
+    }
+    LS_CHECK(bucket.GetSorted(149u).Key == earlier);
+    LS_CHECK(inOrder);
+}
+
+LS_TEST(CommandBucket_SubmitSkipsRedundantBinds)
+{
+    CommandBucket bucket(2u);
+    // 2 pipelines x 3 materials x 4 draws of one geometry, recorded in reverse and split across the buffers
+    uint32_t expectedPrimitives = 0u;
+    for (auto pipeline = 2u; pipeline-- > 0u;)
+    {
+        for (auto material = 3u; material-- > 0u;)
+        {
+            for (auto draw = 0u; draw < 4u; ++draw)
+            {
+                auto& buffer = bucket.GetBuffer(draw % 2u);
+                if (draw == 3u)
+                {
+                    buffer.Draw(0u, draw, pipeline, material, 9u, 6u, 0u, 2u);
+                    expectedPrimitives += 12u;
+                }
+                else
+                {
+                    buffer.DrawIndexed(0u, draw, pipeline, material, 9u, 36u);
+                    expectedPrimitives += 36u;
+                }
+            }
+        }
+    }
+
+    RecordingContext context;
+    const auto stats = bucket.Submit(context);
+    const auto& counters = context.GetCounters();
+
+    LS_CHECK(stats.Draws == 24u);
+    LS_CHECK(stats.PipelineBinds == 2u);
+    LS_CHECK(stats.MaterialBinds == 6u);
+    LS_CHECK(stats.GeometryBinds == 1u);
+    LS_CHECK(stats.RedundantBindsSkipped == 3u * 24u - (2u + 6u + 1u));
+
+    LS_CHECK(counters.Draws == stats.Draws);
+    LS_CHECK(counters.PipelineBinds == stats.PipelineBinds);
+    LS_CHECK(counters.MaterialBinds == stats.MaterialBinds);
+    LS_CHECK(counters.GeometryBinds == stats.GeometryBinds);
+    LS_CHECK(counters.PipelinePrepares == 0u);
+    LS_CHECK(counters.StateChanges() == 9u);
+    LS_CHECK(counters.Primitives == expectedPrimitives);
+
+    // The sorted replay ends on the highest pipeline and material
+    LS_CHECK(context.GetBoundPipeline() == 1u);
+    LS_CHECK(context.GetBoundMaterial() == 2u);
+    LS_CHECK(context.GetBoundGeometry() == 9u);
+}
+
+LS_TEST(CommandBucket_ResetReusesBuffers)
+{
+    CommandBucket bucket(1u);
+    RecordingContext context;
+    for (auto frame = 0u; frame < 3u; ++frame)
+    {
+        for (auto i = 0u; i < 10u; ++i)
+            bucket.GetBuffer(0u).DrawIndexed(0u, i, i % 2u, 0u, 0u, 3u);
+
+        context.ResetCounters();
+        const auto stats = bucket.Submit(context);
+        LS_CHECK(stats.Draws == 10u);
+        LS_CHECK(stats.PipelineBinds == 2u);
+        LS_CHECK(context.GetCounters().Draws == 10u);
+
+        bucket.Reset();
+        LS_CHECK(bucket.Size() == 0u);
+    }
+
+    context.ResetCounters();
+    const auto empty = bucket.Submit(context);
+    LS_CHECK(empty.Draws == 0u);
+    LS_CHECK(context.GetCounters().StateChanges() == 0u);
+}
@@ -0,0 +1,189 @@
+#include "LSTest.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+import Engine.Jobs;
+
+namespace
+{
+    using namespace LS::Jobs;
+
+    constexpr uint32_t STRESS_ROUNDS = 8u;
+
+    // Scheduler sizes covered by every stress test, 1 worker forces the caller to help through Wait
+    constexpr uint32_t WORKER_COUNTS[] = { 1u, 2u, 4u, 7u };
+
+    template <class Func>
+    void ForEachScheduler(Func&& func)
+    {
+        for (const auto workers : WORKER_COUNTS)
+        {
+            LS_REQUIRE(InitJobs(workers));
+            for (auto round = 0u; round < STRESS_ROUNDS; ++round)
+                func();
+            ShutdownJobs();
+        }
+    }
+
+    /**
+     * @brief Splits [first, last) into child jobs down to a leaf size and waits for them from inside the job,
+     * so most of the waits happen on worker threads
+     */
+    void SumRange(uint64_t first, uint64_t last, std::atomic<uint64_t>& sum)
+    {
+        if (last - first <= 64u)
+        {
+            uint64_t local = 0u;
+            for (auto i = first; i < last; ++i)
+                local += i;
+            sum.fetch_add(local);
+            return;
+        }
+
+        const auto mid = first + (last - first) / 2u;
+        JobCounter children;
+        Run([first, mid, &sum]() { SumRange(first, mid, sum); }, &children);
+        Run([mid, last, &sum]() { SumRange(mid, last, sum); }, &children);
+        Wait(children);
+    }
+}
+
+LS_TEST(Jobs_ParallelForVisitsEveryIndexOnce)
+{
+    ForEachScheduler([]()
+        {
+            std::vector<std::atomic<uint32_t>> hits(100'003u);
+            ParallelFor(0u, hits.size(), [&](size_t i) { hits[i].fetch_add(1u); });
+
+            auto wrong = 0u;
+            for (const auto& hit : hits)
+                wrong += hit.load() != 1u;
+            LS_CHECK(wrong == 0u);
+        });
+}
+
+LS_TEST(Jobs_NestedParallelFor)
+{
+    ForEachScheduler([]()
+        {
+            std::atomic<uint64_t> total = 0u;
+            ParallelFor(0u, 64u, [&](size_t)
+                {
+                    ParallelFor(0u, 1000u, [&](size_t first, size_t last) { total.fetch_add(last - first); }, 16u);
+                });
+            LS_CHECK(total.load() == 64'000u);
+        });
+}
+
+LS_TEST(Jobs_WaitFromWorkers)
+{
+    ForEachScheduler([]()
+        {
+            constexpr uint64_t COUNT = 1u << 16;
+            std::atomic<uint64_t> sum = 0u;
+            JobCounter root;
+            Run([&sum]() { SumRange(0u, COUNT, sum); }, &root);
+            Wait(root);
+            LS_CHECK(root.IsDone());
+            LS_CHECK(sum.load() == COUNT * (COUNT - 1u) / 2u);
+        });
+}
+
+LS_TEST(Jobs_ContinuationChainRunsInOrder)
+{
+    ForEachScheduler([]()
+        {
+            constexpr uint32_t LENGTH = 1000u;
+            std::vector<JobCounter> links(LENGTH);
+            std::atomic<uint32_t> step = 0u;
+            std::atomic<uint32_t> outOfOrder = 0u;
+
+            Run([&]() { step.fetch_add(1u); }, &links[0]);
+            for (auto i = 1u; i < LENGTH; ++i)
+            {
+                RunAfter(links[i - 1u], [&, i]()
+                    {
+                        if (step.fetch_add(1u) != i)
+                            outOfOrder.fetch_add(1u);
+                    }, &links[i]);
+            }
+
+            Wait(links.back());
+            LS_CHECK(step.load() == LENGTH);
+            LS_CHECK(outOfOrder.load() == 0u);
+        });
+}
+
+LS_TEST(Jobs_ContinuationsWaitForTheWholeGroup)
+{
+    ForEachScheduler([]()
+        {
+            JobCounter stage1;
+            JobCounter stage2;
+            std::atomic<uint32_t> done1 = 0u;
+            std::atomic<uint32_t> done2 = 0u;
+            std::atomic<uint32_t> early = 0u;
+
+            for (auto i = 0u; i < 1000u; ++i)
+                Run([&]() { done1.fetch_add(1u); }, &stage1);
+            for (auto i = 0u; i < 100u; ++i)
+            {
+                RunAfter(stage1, [&]()
+                    {
+                        if (done1.load() != 1000u)
+                            early.fetch_add(1u);
+                        done2.fetch_add(1u);
+                    }, &stage2);
+            }
+
+            Wait(stage2);
+            LS_CHECK(early.load() == 0u);
+            LS_CHECK(done2.load() == 100u);
+        });
+}
+
+LS_TEST(Jobs_ExternalProducers)
+{
+    ForEachScheduler([]()
+        {
+            JobCounter counter;
+            std::atomic<uint32_t> ran = 0u;
+            std::vector<std::jthread> producers;
+            for (auto t = 0u; t < 4u; ++t)
+            {
+                producers.emplace_back([&]()
+                    {
+                        for (auto i = 0u; i < 5000u; ++i)
+                            Run([&]() { ran.fetch_add(1u); }, &counter);
+                    });
+            }
+            producers.clear();
+
+            Wait(counter);
+            LS_CHECK(ran.load() == 20'000u);
+        });
+}
+
+LS_TEST(Jobs_ShutdownFinishesQueuedJobs)
+{
+    LS_REQUIRE(InitJobs(2u));
+    std::atomic<uint32_t> ran = 0u;
+    for (auto i = 0u; i < 10'000u; ++i)
+        Run([&]() { ran.fetch_add(1u); });
+
+    ShutdownJobs();
+    LS_CHECK(ran.load() == 10'000u);
+    LS_CHECK(!Scheduler);
+
+    // Without a scheduler the free functions run on the calling thread
+    const auto caller = std::this_thread::get_id();
+    auto ranInline = false;
+    JobCounter counter;
+    Run([&]() { ranInline = std::this_thread::get_id() == caller; }, &counter);
+    Wait(counter);
+    LS_CHECK(ranInline);
+    LS_CHECK(counter.IsDone());
+}
@@ -0,0 +1,191 @@
+#include "LSTest.h"
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+import Engine.Logger;
+import Util.StdUtils;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    auto ReadLines(const fs::path& file) -> std::vector<std::string>
+    {
+        std::ifstream stream(file, std::ios::binary);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(stream, line);)
+            lines.emplace_back(std::move(line));
+        return lines;
+    }
+
+    // The message follows the "{time} : [{level}] || " prefix
+    auto MessageOf(const std::string& line) -> std::string
+    {
+        const auto pos = line.find("|| ");
+        return pos == std::string::npos ? std::string{} : line.substr(pos + 3);
+    }
+
+    /**
+     * @brief Logs "{producer} {index}" from each producer thread, all released at once to contend for slots
+     */
+    void LogFromThreads(LS::Log::LSLogger& logger, uint32_t producers, uint32_t messagesPerProducer)
+    {
+        std::atomic<bool> go = false;
+        std::vector<std::jthread> threads;
+        for (auto t = 0u; t < producers; ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    while (!go.load())
+                        std::this_thread::yield();
+                    for (auto i = 0u; i < messagesPerProducer; ++i)
+                        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, std::to_string(t) + " " + std::to_string(i));
+                });
+        }
+        go.store(true);
+    }
+
+    /**
+     * @brief Parses a "{producer} {index}" message
+     */
+    auto ParseProducerMessage(const std::string& message, uint32_t& producer, uint32_t& index) -> bool
+    {
+        const auto space = message.find(' ');
+        if (space == std::string::npos)
+            return false;
+        const auto* end = message.data() + message.size();
+        return std::from_chars(message.data(), message.data() + space, producer).ec == std::errc{}
+            && std::from_chars(message.data() + space + 1, end, index).ptr == end;
+    }
+}
+
+LS_TEST(Logger_WidenUtf8DecodesMultiByte)
+{
+    using LS::Utils::WidenUtf8;
+    LS_CHECK(WidenUtf8("plain") == L"plain");
+    LS_CHECK(WidenUtf8("h\xC3\xA9llo") == std::wstring(L"h\u00E9llo"));
+    LS_CHECK(WidenUtf8("\xE2\x82\xAC") == std::wstring(1, static_cast<wchar_t>(0x20AC)));
+
+    const auto emoji = WidenUtf8("\xF0\x9F\x98\x80");
+    if constexpr (sizeof(wchar_t) == 2)
+        LS_CHECK(emoji.size() == 2u && emoji[0] == static_cast<wchar_t>(0xD83D) && emoji[1] == static_cast<wchar_t>(0xDE00));
+    else
+        LS_CHECK(emoji.size() == 1u && static_cast<uint32_t>(emoji[0]) == 0x1F600u);
+
+    // Cut off, overlong and stray continuation bytes each become one replacement character
+    LS_CHECK(WidenUtf8("a\xC3") == std::wstring(L"a\uFFFD"));
+    LS_CHECK(WidenUtf8("\xC0\x80") == std::wstring(L"\uFFFD"));
+    LS_CHECK(WidenUtf8("\x80z") == std::wstring(L"\uFFFDz"));
+    LS_CHECK(WidenUtf8("\xE2\x82z") == std::wstring(L"\uFFFDz"));
+}
+
+LS_TEST(Logger_WidenUtf8StopsAtFullBuffer)
+{
+    wchar_t out[2]{};
+    const auto result = LS::Utils::WidenUtf8("a\xC3\xA9" "b", out);
+    LS_CHECK(result.Written == 2u);
+    LS_CHECK(result.Read == 3u);
+    LS_CHECK(out[1] == static_cast<wchar_t>(0xE9));
+}
+
+LS_TEST(Logger_AsyncMarksAndCountsTruncation)
+{
+    using LS::Log::AsyncLogger;
+    const LS::Test::TempDir dir("ls_test_logger");
+    const auto file = dir / "async.log";
+    {
+        AsyncLogger logger(file, LS::Log::AsyncLogSettings{ .Capacity = 64, .Overflow = LS::Log::LOG_OVERFLOW::BLOCK });
+        LS_REQUIRE(logger.Init());
+
+        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, std::string_view("short"));
+        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, std::string(AsyncLogger::MAX_MESSAGE_LENGTH, 'a'));
+        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, std::string(1000, 'b'));
+        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, std::wstring(1000, L'c'));
+        // Multi-byte characters are never split by the cut
+        std::string accents;
+        for (auto i = 0u; i < 300u; ++i)
+            accents += "\xC3\xA9";
+        logger.PrintLine(LS::Log::LOG_LEVEL::INFO, accents);
+        logger.Flush();
+
+        LS_CHECK(logger.GetTruncatedCount() == 3u);
+        LS_CHECK(logger.GetDroppedCount() == 0u);
+    }
+
+    const auto lines = ReadLines(file);
+    LS_REQUIRE(lines.size() == 5u);
+    LS_CHECK(MessageOf(lines[0]) == "short");
+    LS_CHECK(MessageOf(lines[1]) == std::string(AsyncLogger::MAX_MESSAGE_LENGTH, 'a'));
+    LS_CHECK(MessageOf(lines[2]) == std::string(AsyncLogger::MAX_MESSAGE_LENGTH - 3u, 'b') + "...");
+    LS_CHECK(MessageOf(lines[3]) == std::string(AsyncLogger::MAX_MESSAGE_LENGTH - 3u, 'c') + "...");
+
+    // Written back out as UTF-8, 241 characters and the marker
+    std::string expected;
+    for (auto i = 0u; i < AsyncLogger::MAX_MESSAGE_LENGTH - 3u; ++i)
+        expected += "\xC3\xA9";
+    LS_CHECK(MessageOf(lines[4]) == expected + "...");
+}
+
+LS_TEST(Logger_AsyncBlockKeepsEveryMessageInProducerOrder)
+{
+    constexpr uint32_t PRODUCERS = 4u;
+    constexpr uint32_t MESSAGES = 5000u;
+    const LS::Test::TempDir dir("ls_test_logger");
+    const auto file = dir / "block.log";
+    {
+        // A small ring makes the producers wait on the writer
+        LS::Log::AsyncLogger logger(file, LS::Log::AsyncLogSettings{ .Capacity = 16, .Overflow = LS::Log::LOG_OVERFLOW::BLOCK });
+        LS_REQUIRE(logger.Init());
+        LogFromThreads(logger, PRODUCERS, MESSAGES);
+        logger.Flush();
+        LS_CHECK(logger.GetDroppedCount() == 0u);
+    }
+
+    const auto lines = ReadLines(file);
+    LS_REQUIRE(lines.size() == PRODUCERS * MESSAGES);
+    std::vector<uint32_t> next(PRODUCERS, 0u);
+    uint32_t outOfOrder = 0u;
+    for (const auto& line : lines)
+    {
+        uint32_t producer = 0u;
+        uint32_t index = 0u;
+        LS_REQUIRE(ParseProducerMessage(MessageOf(line), producer, index) && producer < PRODUCERS);
+        outOfOrder += index == next[producer] ? 0u : 1u;
+        next[producer] = index + 1u;
+    }
+    LS_CHECK(outOfOrder == 0u);
+    for (const auto count : next)
+        LS_CHECK(count == MESSAGES);
+}
+
+LS_TEST(Logger_AsyncDropAccountsForEveryMessage)
+{
+    constexpr uint32_t PRODUCERS = 4u;
+    constexpr uint32_t MESSAGES = 5000u;
+    const LS::Test::TempDir dir("ls_test_logger");
+    const auto file = dir / "drop.log";
+    uint64_t dropped = 0u;
+    {
+        LS::Log::AsyncLogger logger(file, LS::Log::AsyncLogSettings{ .Capacity = 4, .Overflow = LS::Log::LOG_OVERFLOW::DROP });
+        LS_REQUIRE(logger.Init());
+        LogFromThreads(logger, PRODUCERS, MESSAGES);
+        logger.Flush();
+        dropped = logger.GetDroppedCount();
+    }
+
+    // Every message is either written whole or counted as dropped
+    const auto lines = ReadLines(file);
+    for (const auto& line : lines)
+    {
+        uint32_t producer = 0u;
+        uint32_t index = 0u;
+        LS_CHECK(ParseProducerMessage(MessageOf(line), producer, index) && producer < PRODUCERS && index < MESSAGES);
+    }
+    LS_CHECK(lines.size() + dropped == PRODUCERS * MESSAGES);
+}
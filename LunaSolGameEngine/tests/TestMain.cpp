@@ -0,0 +1,7 @@
+#include "LSTest.h"
+
+int main(int argc, char* argv[])
+{
+    const auto filter = argc > 1 ? std::string_view(argv[1]) : std::string_view();
+    return LS::Test::RunAll(LS::Test::GetTests(), filter) == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include "LSTest.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+
+import LSE.Serialize.MeshCache;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr std::string_view QUAD =
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "f 1 2 3 4\n";
+
+    struct TempFiles
+    {
+        LS::Test::TempDir Dir{ "ls_test_mesh_cache" };
+        fs::path Obj = Dir / "source.obj";
+        fs::path Cache = Dir / "source.lsmc";
+
+        TempFiles(std::string_view text)
+        {
+            Write(text);
+        }
+
+        void Write(std::string_view text) const
+        {
+            std::ofstream(Obj, std::ios::binary | std::ios::trunc).write(text.data(), text.size());
+        }
+
+        auto WriteTime() const -> int64_t
+        {
+            return static_cast<int64_t>(fs::last_write_time(Obj).time_since_epoch().count());
+        }
+    };
+}
+
+LS_TEST(MeshCache_BuildsAndLoads)
+{
+    TempFiles files(QUAD);
+    LS::Serialize::MeshCache cache;
+    LS_REQUIRE(LS::Serialize::LoadMeshCached(files.Obj, files.Cache, cache));
+
+    LS_CHECK(cache.GetPositions().size() == 4u);
+    LS_CHECK(cache.GetIndexStride() == sizeof(uint16_t));
+    LS_CHECK(cache.GetIndices<uint16_t>().size() == 6u);
+    LS_CHECK(cache.GetIndices<uint32_t>().empty());
+    LS_CHECK(cache.IsCurrent(files.Obj));
+
+    auto tempFile = files.Cache;
+    tempFile += ".tmp";
+    LS_CHECK(!fs::exists(tempFile));
+}
+
+LS_TEST(MeshCache_TouchedSourceRefreshesWriteTime)
+{
+    TempFiles files(QUAD);
+    {
+        LS::Serialize::MeshCache cache;
+        LS_REQUIRE(LS::Serialize::LoadMeshCached(files.Obj, files.Cache, cache));
+    }
+
+    // Same contents with a new write time, as after a checkout or copy
+    fs::last_write_time(files.Obj, fs::last_write_time(files.Obj) + std::chrono::hours(1));
+
+    LS::Serialize::MeshCache cache;
+    LS_REQUIRE(cache.Load(files.Cache));
+    LS_CHECK(cache.GetHeader().SourceWriteTime != files.WriteTime());
+    LS_CHECK(cache.IsCurrent(files.Obj));
+    LS_CHECK(cache.GetHeader().SourceWriteTime == files.WriteTime());
+    LS_CHECK(cache.GetPositions().size() == 4u);
+
+    // The refreshed time was written to the file, not only to the loaded header
+    LS::Serialize::MeshCache reloaded;
+    LS_REQUIRE(reloaded.Load(files.Cache));
+    LS_CHECK(reloaded.GetHeader().SourceWriteTime == files.WriteTime());
+}
+
+LS_TEST(MeshCache_ChangedSourceRebuilds)
+{
+    TempFiles files(QUAD);
+    LS::Serialize::MeshCache cache;
+    LS_REQUIRE(LS::Serialize::LoadMeshCached(files.Obj, files.Cache, cache));
+
+    files.Write("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n");
+    LS_CHECK(!cache.IsCurrent(files.Obj));
+
+    LS_REQUIRE(LS::Serialize::LoadMeshCached(files.Obj, files.Cache, cache));
+    LS_CHECK(cache.GetPositions().size() == 3u);
+    LS_CHECK(cache.GetIndices<uint16_t>().size() == 3u);
+    LS_CHECK(cache.IsCurrent(files.Obj));
+}
+
+LS_TEST(MeshCache_IsCurrentHashesOnlySameSizeSources)
+{
+    TempFiles files(QUAD);
+    LS::Serialize::MeshCache cache;
+    LS_REQUIRE(LS::Serialize::LoadMeshCached(files.Obj, files.Cache, cache));
+
+    // A different size is stale without reading the contents
+    files.Write("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n");
+    std::optional<LS::Serialize::MeshSourceInfo> described;
+    LS_CHECK(!cache.IsCurrent(files.Obj, &described));
+    LS_CHECK(!described);
+
+    // Same size and a new write time is hashed, and the description is handed back for the rebuild
+    files.Write("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 4 3 2 1\n");
+    fs::last_write_time(files.Obj, fs::last_write_time(files.Obj) + std::chrono::hours(1));
+    LS_CHECK(!cache.IsCurrent(files.Obj, &described));
+    LS_REQUIRE(described.has_value());
+    const auto expected = LS::Serialize::DescribeMeshSource(files.Obj);
+    LS_REQUIRE(expected.has_value());
+    LS_CHECK(described->Hash == expected->Hash);
+    LS_CHECK(described->Size == expected->Size);
+    LS_CHECK(described->WriteTime == files.WriteTime());
+
+    LS_REQUIRE(LS::Serialize::LoadMeshCached(files.Obj, files.Cache, cache));
+    LS_CHECK(cache.GetHeader().SourceHash == expected->Hash);
+    LS_CHECK(cache.IsCurrent(files.Obj));
+}
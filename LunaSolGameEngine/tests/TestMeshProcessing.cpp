@@ -0,0 +1,337 @@
+#include "LSTest.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+import LSDataLib;
+import MeshProcessing;
+import GeometryGenerator;
+
+namespace
+{
+    using namespace LS::Geo;
+
+    // Closed UV sphere with a single vertex at each pole, so no vertex is locked as a border
+    auto CreateSphere(uint32_t rings, uint32_t segments) -> Mesh::MeshData
+    {
+        Mesh::MeshData mesh;
+        mesh.Vertices.push_back(Mesh::MeshVertex{ .Position = { 0.0f, 1.0f, 0.0f }, .Normal = { 0.0f, 1.0f, 0.0f } });
+        for (auto r = 1u; r < rings; ++r)
+        {
+            const auto theta = 3.14159265f * static_cast<float>(r) / static_cast<float>(rings);
+            for (auto s = 0u; s < segments; ++s)
+            {
+                const auto phi = 6.28318531f * static_cast<float>(s) / static_cast<float>(segments);
+                const LS::Vec3F p{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+                mesh.Vertices.push_back(Mesh::MeshVertex{ .Position = p, .Normal = p });
+            }
+        }
+        mesh.Vertices.push_back(Mesh::MeshVertex{ .Position = { 0.0f, -1.0f, 0.0f }, .Normal = { 0.0f, -1.0f, 0.0f } });
+
+        const auto ring = [&](uint32_t r, uint32_t s) { return 1u + (r - 1u) * segments + s % segments; };
+        const auto bottom = static_cast<uint32_t>(mesh.Vertices.size() - 1u);
+        for (auto s = 0u; s < segments; ++s)
+        {
+            mesh.Indices.insert(mesh.Indices.end(), { 0u, ring(1u, s + 1u), ring(1u, s) });
+            for (auto r = 1u; r + 1u < rings; ++r)
+            {
+                mesh.Indices.insert(mesh.Indices.end(), { ring(r, s), ring(r, s + 1u), ring(r + 1u, s + 1u) });
+                mesh.Indices.insert(mesh.Indices.end(), { ring(r, s), ring(r + 1u, s + 1u), ring(r + 1u, s) });
+            }
+            mesh.Indices.insert(mesh.Indices.end(), { ring(rings - 1u, s), ring(rings - 1u, s + 1u), bottom });
+        }
+        return mesh;
+    }
+
+    // Every edge of a closed manifold mesh is shared by exactly two triangles
+    auto IsClosedManifold(const std::vector<uint32_t>& indices) -> bool
+    {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> edges;
+        for (size_t i = 0u; i < indices.size(); i += 3u)
+        {
+            for (auto c = 0u; c < 3u; ++c)
+            {
+                const auto a = indices[i + c];
+                const auto b = indices[i + (c + 1u) % 3u];
+                ++edges[std::minmax(a, b)];
+            }
+        }
+        return std::ranges::all_of(edges, [](const auto& edge) { return edge.second == 2u; });
+    }
+
+    auto Hills(float x, float z) -> float
+    {
+        return std::sin(x * 0.3f) * std::cos(z * 0.2f) * 2.0f;
+    }
+
+    // Mimics an unordered import
+    void ShuffleTriangles(std::vector<uint32_t>& indices, uint32_t seed)
+    {
+        LS::Test::Random random(seed);
+        for (size_t i = indices.size() / 3u - 1u; i > 0u; --i)
+        {
+            const auto j = random.Next(static_cast<uint32_t>(i + 1u));
+            std::swap_ranges(indices.begin() + i * 3u, indices.begin() + i * 3u + 3u, indices.begin() + j * 3u);
+        }
+    }
+
+    auto SamePosition(const LS::Vec3F& a, const LS::Vec3F& b) -> bool
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    // Triangles rotated to start at their smallest index, then sorted
+    auto SortedTriangles(const std::vector<uint32_t>& indices) -> std::vector<std::array<uint32_t, 3>>
+    {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (size_t i = 0u; i < indices.size(); i += 3u)
+        {
+            std::array<uint32_t, 3> tri{ indices[i], indices[i + 1u], indices[i + 2u] };
+            std::ranges::rotate(tri, std::ranges::min_element(tri));
+            triangles.push_back(tri);
+        }
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+}
+
+LS_TEST(MeshProcessing_AnalyzeVertexCacheCountsMisses)
+{
+    const std::vector<uint32_t> single{ 0u, 1u, 2u };
+    const auto one = Mesh::AnalyzeVertexCache(single, 3u);
+    LS_CHECK(one.Transformed == 3u);
+    LS_CHECK(one.Acmr == 3.0f);
+    LS_CHECK(one.Atvr == 1.0f);
+
+    // The second triangle of a quad reuses two cached vertices
+    const std::vector<uint32_t> quad{ 0u, 1u, 2u, 0u, 2u, 3u };
+    const auto two = Mesh::AnalyzeVertexCache(quad, 4u);
+    LS_CHECK(two.Transformed == 4u);
+    LS_CHECK(two.Acmr == 2.0f);
+    LS_CHECK(two.Atvr == 1.0f);
+}
+
+LS_TEST(MeshProcessing_OptimizeVertexCacheKeepsTrianglesAndLowersAcmr)
+{
+    auto grid = Generator::CreateGridLH(64u, 64u);
+    ShuffleTriangles(grid.Indices, 7u);
+
+    const auto before = Mesh::AnalyzeVertexCache(grid.Indices, grid.Vertices.size());
+    const auto triangles = SortedTriangles(grid.Indices);
+    Mesh::OptimizeVertexCache(grid.Indices, grid.Vertices.size());
+    const auto after = Mesh::AnalyzeVertexCache(grid.Indices, grid.Vertices.size());
+
+    LS_CHECK(SortedTriangles(grid.Indices) == triangles);
+    LS_CHECK(after.Acmr < before.Acmr);
+    LS_CHECK(after.Acmr < 0.8f);
+    LS_CHECK(after.Atvr < 1.5f);
+}
+
+LS_TEST(MeshProcessing_SimplifyKeepsClosedMeshManifold)
+{
+    const auto sphere = CreateSphere(24u, 32u);
+    LS_REQUIRE(IsClosedManifold(sphere.Indices));
+
+    for (const size_t target : { size_t{ 400u }, size_t{ 100u }, size_t{ 20u } })
+    {
+        const auto lod = Mesh::SimplifyMesh(sphere.Indices, sphere.Vertices, target);
+        LS_CHECK(lod.Indices.size() / 3u < sphere.TriangleCount());
+        LS_CHECK(IsClosedManifold(lod.Indices));
+    }
+}
+
+LS_TEST(MeshProcessing_SimplifyRespectsLinkCondition)
+{
+    // Triangular bipyramid: the equator edges share three neighbours but border only two triangles, so only a pole
+    // can collapse. That leaves a tetrahedron, where any further collapse would fold it into two coincident triangles.
+    Mesh::MeshData mesh;
+    const std::array<LS::Vec3F, 5> positions{ LS::Vec3F{ 0.0f, 1.0f, 0.0f }, LS::Vec3F{ 1.0f, 0.0f, 0.0f },
+        LS::Vec3F{ -0.5f, 0.0f, 0.866f }, LS::Vec3F{ -0.5f, 0.0f, -0.866f }, LS::Vec3F{ 0.0f, -1.0f, 0.0f } };
+    for (const auto& p : positions)
+        mesh.Vertices.push_back(Mesh::MeshVertex{ .Position = p, .Normal = p });
+    mesh.Indices = { 0u, 1u, 2u, 0u, 2u, 3u, 0u, 3u, 1u, 4u, 2u, 1u, 4u, 3u, 2u, 4u, 1u, 3u };
+    LS_REQUIRE(IsClosedManifold(mesh.Indices));
+
+    const auto lod = Mesh::SimplifyMesh(mesh.Indices, mesh.Vertices, 1u);
+    LS_CHECK(IsClosedManifold(lod.Indices));
+    LS_CHECK(lod.Indices.size() / 3u == 4u);
+}
+
+LS_TEST(MeshProcessing_CreateTerrainLayout)
+{
+    // A constant slope of 0.5 along X
+    const auto terrain = Generator::CreateTerrainLH(8u, 4u, 2.0f, LS::Vec2F{ 10.0f, -4.0f }, [](float x, float) { return 0.5f * x; });
+    LS_REQUIRE(terrain.Vertices.size() == 9u * 5u);
+    LS_REQUIRE(terrain.TriangleCount() == 8u * 4u * 2u);
+
+    const auto& last = terrain.Vertices.back();
+    LS_CHECK(SamePosition(terrain.Vertices.front().Position, LS::Vec3F{ 10.0f, 5.0f, -4.0f }));
+    LS_CHECK(SamePosition(last.Position, LS::Vec3F{ 26.0f, 13.0f, 4.0f }));
+    LS_CHECK(last.TexCoord.x == 1.0f && last.TexCoord.y == 1.0f);
+
+    // The normal of the slope is (-0.5, 1, 0) normalized
+    const auto expected = 1.0f / std::sqrt(1.25f);
+    for (const auto& vertex : terrain.Vertices)
+        LS_CHECK(std::abs(vertex.Normal.x + 0.5f * expected) < 1e-5f && std::abs(vertex.Normal.y - expected) < 1e-5f);
+
+    // Clockwise seen from +Y, so in a left handed frame the cross product of the edges points up
+    for (size_t i = 0u; i < terrain.Indices.size(); i += 3u)
+    {
+        const auto& a = terrain.Vertices[terrain.Indices[i]].Position;
+        const auto& b = terrain.Vertices[terrain.Indices[i + 1u]].Position;
+        const auto& c = terrain.Vertices[terrain.Indices[i + 2u]].Position;
+        LS_CHECK((b.z - a.z) * (c.x - a.x) - (b.x - a.x) * (c.z - a.z) > 0.0f);
+    }
+
+    LS_CHECK(Generator::CreateGridLH(0u, 4u).Vertices.empty());
+}
+
+LS_TEST(MeshProcessing_WeldMergesDuplicatesAndSignedZero)
+{
+    const auto grid = Generator::CreateGridLH(2u, 1u);
+    std::vector<Mesh::MeshVertex> corners;
+    for (const auto index : grid.Indices)
+        corners.push_back(grid.Vertices[index]);
+    // The first vertex sits at the origin, a -0 copy of it must still weld
+    LS_REQUIRE(corners[0].Position.x == 0.0f);
+    corners[0].Position.x = -0.0f;
+
+    const auto welded = Mesh::WeldVertices(corners);
+    LS_CHECK(welded.Vertices.size() == grid.Vertices.size());
+    LS_REQUIRE(welded.Indices.size() == corners.size());
+    for (size_t i = 0u; i < corners.size(); ++i)
+        LS_CHECK(welded.Vertices[welded.Indices[i]].Position.x == corners[i].Position.x);
+    LS_CHECK(welded.Indices[0] == 0u);
+
+    // Any other attribute difference keeps vertices apart
+    corners[3].TexCoord.x += 0.5f;
+    LS_CHECK(Mesh::WeldVertices(corners).Vertices.size() == grid.Vertices.size() + 1u);
+
+    // Indexed input
+    const auto reindexed = Mesh::WeldVertices(grid.Vertices, grid.Indices);
+    LS_CHECK(reindexed.Vertices.size() == grid.Vertices.size());
+    LS_CHECK(reindexed.Indices.size() == grid.Indices.size());
+}
+
+LS_TEST(MeshProcessing_WeldCornersJoinsStreams)
+{
+    const std::vector<LS::Vec3F> positions{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f } };
+    const std::vector<LS::Vec3F> normals{ { 0.0f, 1.0f, 0.0f } };
+    const std::vector<LS::Vec2F> texCoords{ { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+    // A quad as two triangles, the last corner names a normal that does not exist
+    const std::vector<uint32_t> positionIndices{ 0u, 1u, 2u, 0u, 2u, 3u };
+    const std::vector<uint32_t> normalIndices{ 0u, 0u, 0u, 0u, 0u, 7u };
+    const std::vector<uint32_t> texCoordIndices{ 0u, 1u, 1u, 0u, 1u, 0u };
+
+    const auto mesh = Mesh::WeldCorners(positions, normals, texCoords, positionIndices, normalIndices, texCoordIndices);
+    LS_CHECK(mesh.Vertices.size() == 4u);
+    LS_REQUIRE(mesh.Indices.size() == 6u);
+    LS_CHECK(mesh.Indices[0] == mesh.Indices[3] && mesh.Indices[2] == mesh.Indices[4]);
+    for (size_t i = 0u; i < 6u; ++i)
+        LS_CHECK(SamePosition(mesh.Vertices[mesh.Indices[i]].Position, positions[positionIndices[i]]));
+    LS_CHECK(mesh.Vertices[mesh.Indices[5]].Normal.y == 0.0f);
+    LS_CHECK(mesh.Vertices[mesh.Indices[0]].Normal.y == 1.0f);
+
+    // Without normal and texture coordinate streams every corner with the same position welds
+    const auto positionsOnly = Mesh::WeldCorners(positions, {}, {}, positionIndices, {}, {});
+    LS_CHECK(positionsOnly.Vertices.size() == 4u);
+}
+
+LS_TEST(MeshProcessing_QuantizeErrorWithinHalfStep)
+{
+    const auto terrain = Generator::CreateTerrainLH(32u, 32u, 0.75f, LS::Vec2F{ -5.0f, 3.0f }, Hills);
+    const auto quantized = Mesh::QuantizeVertices(terrain.Vertices);
+    LS_REQUIRE(quantized.Vertices.size() == terrain.Vertices.size());
+
+    const auto bound = [](float extent) { return extent / 65535.0f * 0.5f + extent * 1e-6f; };
+    for (size_t i = 0u; i < terrain.Vertices.size(); ++i)
+    {
+        const auto& source = terrain.Vertices[i];
+        const auto& vertex = quantized.Vertices[i];
+        const auto position = Mesh::DequantizePosition(quantized, vertex);
+        LS_CHECK(std::abs(position.x - source.Position.x) <= bound(quantized.Scale.x));
+        LS_CHECK(std::abs(position.y - source.Position.y) <= bound(quantized.Scale.y));
+        LS_CHECK(std::abs(position.z - source.Position.z) <= bound(quantized.Scale.z));
+        LS_CHECK(std::abs(vertex.Normal[1] / 32767.0f - source.Normal.y) <= 0.5f / 32767.0f + 1e-6f);
+        LS_CHECK(vertex.Position[3] == 0u && vertex.Normal[3] == 0);
+    }
+
+    // A flat axis has no extent and dequantizes to the offset exactly
+    const auto flat = Mesh::QuantizeVertices(Generator::CreateGridLH(4u, 4u).Vertices);
+    LS_CHECK(flat.Scale.y == 0.0f);
+    LS_CHECK(Mesh::DequantizePosition(flat, flat.Vertices[7]).y == 0.0f);
+}
+
+LS_TEST(MeshProcessing_OverdrawKeepsTrianglesWithinThreshold)
+{
+    auto terrain = Generator::CreateTerrainLH(96u, 96u, 1.0f, {}, Hills);
+    ShuffleTriangles(terrain.Indices, 11u);
+    Mesh::OptimizeVertexCache(terrain.Indices, terrain.Vertices.size());
+    const auto triangles = SortedTriangles(terrain.Indices);
+
+    for (const auto threshold : { 1.05f, 1.25f })
+    {
+        auto indices = terrain.Indices;
+        const auto before = Mesh::AnalyzeVertexCache(indices, terrain.Vertices.size());
+        Mesh::OptimizeOverdraw(indices, terrain.Vertices, threshold);
+        const auto after = Mesh::AnalyzeVertexCache(indices, terrain.Vertices.size());
+
+        LS_CHECK(SortedTriangles(indices) == triangles);
+        LS_CHECK(after.Acmr <= before.Acmr * threshold);
+    }
+}
+
+LS_TEST(MeshProcessing_VertexFetchOrdersByFirstUse)
+{
+    auto mesh = Generator::CreateTerrainLH(16u, 16u, 1.0f, {}, Hills);
+    ShuffleTriangles(mesh.Indices, 5u);
+    // Drop a triangle so one corner vertex is no longer referenced
+    const auto original = mesh;
+    mesh.Indices.erase(mesh.Indices.begin(), mesh.Indices.begin() + 3);
+    const auto corners = std::vector<uint32_t>(original.Indices.begin() + 3, original.Indices.end());
+
+    Mesh::OptimizeVertexFetch(mesh);
+    LS_REQUIRE(mesh.Indices.size() == corners.size());
+    uint32_t next = 0u;
+    for (size_t i = 0u; i < corners.size(); ++i)
+    {
+        LS_CHECK(SamePosition(mesh.Vertices[mesh.Indices[i]].Position, original.Vertices[corners[i]].Position));
+        // Each index is either already seen or the next new one
+        LS_CHECK(mesh.Indices[i] <= next);
+        next += mesh.Indices[i] == next ? 1u : 0u;
+    }
+    LS_CHECK(next == mesh.Vertices.size());
+    LS_CHECK(mesh.Vertices.size() <= original.Vertices.size());
+}
+
+LS_TEST(MeshProcessing_LodChainIsMonotonic)
+{
+    const auto terrain = Generator::CreateTerrainLH(64u, 64u, 1.0f, {}, Hills);
+    const auto count = terrain.TriangleCount();
+    const std::vector<size_t> targets{ count / 2u, count / 4u, count / 8u, count / 16u };
+
+    const auto lods = Mesh::BuildLodChain(terrain, targets);
+    LS_REQUIRE(lods.size() == targets.size());
+
+    auto previousCount = count;
+    auto previousError = 0.0f;
+    for (size_t i = 0u; i < lods.size(); ++i)
+    {
+        const auto& lod = lods[i];
+        const auto triangles = lod.Indices.size() / 3u;
+        LS_CHECK(lod.Indices.size() % 3u == 0u);
+        LS_CHECK(triangles < previousCount);
+        LS_CHECK(lod.Error >= previousError);
+        LS_CHECK(std::ranges::all_of(lod.Indices, [&](uint32_t index) { return index < terrain.Vertices.size(); }));
+        previousCount = triangles;
+        previousError = lod.Error;
+    }
+    // The first level only has to remove flat-ish interior triangles, so it reaches its target
+    LS_CHECK(lods.front().Indices.size() / 3u <= targets.front());
+    LS_CHECK(lods.back().Error > 0.0f);
+}
@@ -0,0 +1,170 @@
+#include "LSTest.h"
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+import Engine.LSDevice;
+import Engine.PipelineCache;
+import Engine.Shader;
+import LSDataLib;
+
+namespace
+{
+    using namespace LS;
+
+    auto MakeBytes(size_t size, uint8_t seed) -> std::vector<std::byte>
+    {
+        std::vector<std::byte> bytes(size);
+        for (auto i = 0u; i < size; ++i)
+            bytes[i] = static_cast<std::byte>((i * 31u + seed) & 0xFFu);
+        return bytes;
+    }
+
+    auto MakePipeline(uint8_t shaderSeed = 1u) -> PipelineDescriptor
+    {
+        PipelineDescriptor pipeline{};
+        pipeline.RasterizeState = RasterizerInfo{ .Fill = FILL_STATE::FILL, .Cull = CULL_METHOD::BACK };
+        pipeline.BlendState.BlendType = BlendType::OPAQUE_BLEND;
+        pipeline.DepthStencil.IsDepthEnabled = true;
+        pipeline.DepthStencil.DepthBufferWriteAll = true;
+        pipeline.Shaders[SHADER_TYPE::VERTEX] = MakeBytes(512u, shaderSeed);
+        pipeline.Shaders[SHADER_TYPE::PIXEL] = MakeBytes(1024u, static_cast<uint8_t>(shaderSeed + 1u));
+        pipeline.ShaderSignature.AddElement(ShaderElement{ .SemanticName = "POSITION" });
+        pipeline.ShaderSignature.AddElement(ShaderElement{ .SemanticName = "TEXCOORD", .OffsetAligned = 12u });
+        pipeline.Topology = PRIMITIVE_TOPOLOGY::TRIANGLE_LIST;
+        pipeline.RenderTarget.PixelFormat = PIXEL_COLOR_FORMAT::RGBA8_UNORM;
+        pipeline.RenderTarget.SampleCount = 1u;
+        pipeline.Samplers.push_back(SamplerMap{ .BindSlot = 0u, .Sampler = LSSamplerState{ .AnisotropyLevel = 4u } });
+        return pipeline;
+    }
+}
+
+LS_TEST(PipelineCache_EqualDescriptorsShareAHandle)
+{
+    PipelineCache cache;
+    const auto pipeline = MakePipeline();
+    const auto handle = cache.Intern(pipeline);
+    LS_CHECK(handle != INVALID_STATE_HANDLE);
+    LS_CHECK(cache.Intern(pipeline) == handle);
+
+    // Per draw bindings are not part of the pipeline
+    auto withBindings = pipeline;
+    withBindings.Textures.push_back(TextureMap{ .BindSlot = 3u });
+    LS_CHECK(cache.Intern(withBindings) == handle);
+
+    const auto stats = cache.GetStats();
+    LS_CHECK(stats.Pipelines.Lookups == 3u);
+    LS_CHECK(stats.Pipelines.Hits == 2u);
+    LS_CHECK(stats.PipelineCount == 1u);
+    LS_CHECK(stats.ShaderSetCount == 1u);
+}
+
+LS_TEST(PipelineCache_EquivalentStatesShareAHandle)
+{
+    PipelineCache cache;
+    auto a = MakePipeline();
+    a.DepthStencil.IsDepthEnabled = false;
+    a.DepthStencil.DepthComparison = EVAL_COMPARE::LESS_PASS;
+    auto b = a;
+    b.DepthStencil.DepthComparison = EVAL_COMPARE::GREATER_PASS;
+    LS_CHECK(cache.Intern(a) == cache.Intern(b));
+}
+
+LS_TEST(PipelineCache_DistinctFieldsGetDistinctHandles)
+{
+    PipelineCache cache;
+    const auto base = MakePipeline();
+    const auto handle = cache.Intern(base);
+
+    auto shader = base;
+    shader.Shaders[SHADER_TYPE::PIXEL].back() ^= std::byte{ 1 };
+    auto signature = base;
+    signature.ShaderSignature.Elements[1].OffsetAligned = 16u;
+    auto sampler = base;
+    sampler.Samplers[0].BindSlot = 1u;
+    auto topology = base;
+    topology.Topology = PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP;
+    auto samples = base;
+    samples.RenderTarget.SampleCount = 4u;
+
+    std::vector<StateHandle> handles = { handle };
+    for (const auto* variant : { &shader, &signature, &sampler, &topology, &samples })
+    {
+        const auto variantHandle = cache.Intern(*variant);
+        for (const auto seen : handles)
+            LS_CHECK(variantHandle != seen);
+        handles.push_back(variantHandle);
+        LS_CHECK(cache.Intern(*variant) == variantHandle);
+    }
+
+    LS_CHECK(cache.GetStats().PipelineCount == 6u);
+    LS_CHECK(cache.GetShaders(cache.GetPipeline(handles[1]).Shaders) == shader.Shaders);
+    LS_CHECK(cache.GetShaders(cache.GetPipeline(handle).Shaders) == base.Shaders);
+}
+
+LS_TEST(PipelineCache_StateTableChainsCollidingKeys)
+{
+    StateTable<std::vector<int>> table;
+    const auto a = table.Intern({ 1, 2 }, 42u);
+    const auto b = table.Intern({ 3 }, 42u);
+    LS_CHECK(!a.second && !b.second);
+    LS_CHECK(a.first != b.first);
+    LS_CHECK(table.Intern({ 3 }, 42u).first == b.first);
+    LS_CHECK(table.Intern({ 1, 2 }, 42u).first == a.first);
+    LS_CHECK(table.Get(b.first) == std::vector<int>{ 3 });
+}
+
+LS_TEST(PipelineCache_ConcurrentInternAgrees)
+{
+    PipelineCache cache;
+    constexpr uint32_t PIPELINES = 32u;
+    std::vector<PipelineDescriptor> pipelines;
+    for (auto i = 0u; i < PIPELINES; ++i)
+        pipelines.push_back(MakePipeline(static_cast<uint8_t>(i * 2u)));
+
+    std::vector<std::vector<StateHandle>> results(4u, std::vector<StateHandle>(PIPELINES));
+    {
+        std::vector<std::jthread> threads;
+        for (auto t = 0u; t < results.size(); ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    for (auto round = 0u; round < 50u; ++round)
+                    {
+                        for (auto i = 0u; i < PIPELINES; ++i)
+                            results[t][(i + t) % PIPELINES] = cache.Intern(pipelines[(i + t) % PIPELINES]);
+                    }
+                });
+        }
+    }
+
+    for (auto t = 1u; t < results.size(); ++t)
+        LS_CHECK(results[t] == results[0]);
+    LS_CHECK(cache.GetStats().PipelineCount == PIPELINES);
+}
+
+LS_TEST(PipelineCache_ShaderSetMatchesShaderBlobs)
+{
+    PipelineCache cache;
+    const auto pipeline = MakePipeline();
+    const auto handle = cache.Intern(pipeline);
+
+    // A descriptor keyed by its interned shaders finds the same pipeline without carrying the blobs
+    auto keyed = pipeline;
+    keyed.ShaderSet = cache.InternShaders(pipeline.Shaders);
+    keyed.Shaders.clear();
+    LS_CHECK(keyed.ShaderSet == cache.GetPipeline(handle).Shaders);
+    LS_CHECK(cache.Intern(keyed) == handle);
+
+    auto other = MakePipeline(7u);
+    other.ShaderSet = cache.InternShaders(other.Shaders);
+    const auto otherHandle = cache.Intern(other);
+    LS_CHECK(otherHandle != handle);
+    other.ShaderSet = INVALID_STATE_HANDLE;
+    LS_CHECK(cache.Intern(other) == otherHandle);
+
+    const auto stats = cache.GetStats();
+    LS_CHECK(stats.PipelineCount == 2u);
+    LS_CHECK(stats.ShaderSetCount == 2u);
+}
@@ -0,0 +1,144 @@
+#include "LSTest.h"
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <thread>
+
+#define LS_ENABLE_PROFILE 1
+#include "engine/EngineProfileDefines.h"
+
+namespace
+{
+    auto ExportTrace() -> std::string
+    {
+        const LS::Test::TempDir dir("ls_test_profiler");
+        const auto file = dir / "trace.json";
+        if (!LS::Profile::ExportChromeTrace(file))
+            return {};
+
+        std::ifstream stream(file, std::ios::binary);
+        return std::string{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+    }
+}
+
+LS_TEST(Profiler_FrameNumberIsMonotonic)
+{
+    LS::Profile::Reset();
+    LS::Profile::SetEnabled(true);
+
+    // More frames than a swap chain has back buffers, the numbers must keep counting instead of wrapping
+    const auto first = LS::Profile::GetFrameNumber();
+    for (auto i = 0u; i < 8u; ++i)
+        LS_PROFILE_FRAME();
+    LS_CHECK(LS::Profile::GetFrameNumber() == first + 8u);
+
+    const auto trace = ExportTrace();
+    LS_CHECK(trace.find(std::format("\"frame\":{}}}", first + 7u)) != std::string::npos);
+
+    LS::Profile::Reset();
+    LS_CHECK(LS::Profile::GetFrameNumber() == first + 8u);
+    LS::Profile::SetEnabled(false);
+}
+
+LS_TEST(Profiler_ExitedThreadEventsExportOnce)
+{
+    LS::Profile::Reset();
+    LS::Profile::SetEnabled(true);
+    std::jthread([]()
+        {
+            LS_PROFILE_THREAD("Exited worker");
+            LS_PROFILE_ZONE("Exited zone");
+        }).join();
+    LS::Profile::SetEnabled(false);
+
+    // The thread is gone but its events stay until they have been exported
+    const auto first = ExportTrace();
+    LS_CHECK(first.find("Exited worker") != std::string::npos);
+    LS_CHECK(first.find("Exited zone") != std::string::npos);
+
+    const auto second = ExportTrace();
+    LS_REQUIRE(!second.empty());
+    LS_CHECK(second.find("Exited worker") == std::string::npos);
+    LS_CHECK(second.find("Exited zone") == std::string::npos);
+}
+
+LS_TEST(Profiler_ExitedThreadBuffersAreReused)
+{
+    LS::Profile::Reset();
+    LS::Profile::SetEnabled(true);
+    const auto record = []()
+        {
+            std::jthread([]()
+                {
+                    LS_PROFILE_ZONE("Short lived");
+                }).join();
+        };
+
+    // Without exports the retired list is capped, past it new threads take the oldest buffers
+    const auto before = LS::Profile::GetThreadBufferCount();
+    for (auto i = 0u; i < LS::Profile::MAX_RETIRED_THREAD_BUFFERS * 4u; ++i)
+        record();
+    LS_CHECK(LS::Profile::GetThreadBufferCount() <= before + LS::Profile::MAX_RETIRED_THREAD_BUFFERS + 1u);
+
+    // After an export every retired buffer is free again
+    LS_REQUIRE(!ExportTrace().empty());
+    const auto exported = LS::Profile::GetThreadBufferCount();
+    for (auto i = 0u; i < LS::Profile::MAX_RETIRED_THREAD_BUFFERS; ++i)
+        record();
+    LS_CHECK(LS::Profile::GetThreadBufferCount() == exported);
+    LS::Profile::SetEnabled(false);
+}
+
+LS_TEST(Profiler_FrameSummaryCountsIntervals)
+{
+    LS::Profile::Reset();
+    for (auto i = 0u; i < 5u; ++i)
+        LS::Profile::MarkFrame();
+
+    const auto summary = LS::Profile::GetFrameSummary();
+    LS_CHECK(summary.FrameCount == 4u);
+    LS_CHECK(summary.MinMs <= summary.P95Ms && summary.P95Ms <= summary.MaxMs);
+}
+
+LS_TEST(Profiler_NonFiniteCountersExportAsNull)
+{
+    LS::Profile::Reset();
+    LS::Profile::SetEnabled(true);
+    LS_PROFILE_COUNTER("finite", 2.5);
+    LS_PROFILE_COUNTER("overflow", std::numeric_limits<double>::infinity());
+    LS_PROFILE_COUNTER("underflow", -std::numeric_limits<double>::infinity());
+    LS_PROFILE_COUNTER("undefined", std::numeric_limits<double>::quiet_NaN());
+    LS::Profile::SetEnabled(false);
+
+    const auto trace = ExportTrace();
+    LS_REQUIRE(!trace.empty());
+    LS_CHECK(trace.find("\"value\":2.5}") != std::string::npos);
+    LS_CHECK(trace.find("\"value\":null}") != std::string::npos);
+    LS_CHECK(trace.find("inf") == std::string::npos);
+    LS_CHECK(trace.find("nan") == std::string::npos);
+}
+
+LS_TEST(Profiler_ZonesNestAndExport)
+{
+    LS::Profile::Reset();
+    LS::Profile::SetEnabled(true);
+    {
+        LS_PROFILE_ZONE("Outer");
+        {
+            LS_PROFILE_ZONE("Inner \"quoted\"");
+        }
+    }
+    LS::Profile::SetEnabled(false);
+    {
+        LS_PROFILE_ZONE("Disabled");
+    }
+
+    const auto trace = ExportTrace();
+    LS_CHECK(trace.find("\"name\":\"Outer\",\"cat\":\"zone\"") != std::string::npos);
+    LS_CHECK(trace.find("\"name\":\"Inner \\\"quoted\\\"\"") != std::string::npos);
+    LS_CHECK(trace.find("\"depth\":1") != std::string::npos);
+    LS_CHECK(trace.find("Disabled") == std::string::npos);
+}
@@ -0,0 +1,200 @@
+#include "LSTest.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+import LSDataLib;
+import MathLib;
+
+namespace
+{
+    using namespace LS;
+    using namespace LS::Math;
+
+    constexpr float TOLERANCE = 1e-4f;
+
+    auto MakeMatrix(std::array<float, 16> values) -> Mat4F
+    {
+        Mat4F m{};
+        m.Mat = values;
+        return m;
+    }
+
+    // Deterministic values in [-1, 1) so failures reproduce
+    auto Signed(LS::Test::Random& rng) -> float
+    {
+        return rng.NextFloat() * 2.0f - 1.0f;
+    }
+
+    // Diagonally dominant, so always invertible and well conditioned
+    auto RandomMatrix(LS::Test::Random& rng) -> Mat4F
+    {
+        Mat4F m{};
+        for (auto i = 0u; i < 16u; ++i)
+            m.Mat[i] = Signed(rng) + (i % 5u == 0u ? 4.0f : 0.0f);
+        return m;
+    }
+
+    auto Near(float a, float b) -> bool
+    {
+        return std::abs(a - b) <= TOLERANCE * std::max(1.0f, std::abs(b));
+    }
+
+    auto Near(const Mat4F& a, const Mat4F& b) -> bool
+    {
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            if (!Near(a.Mat[i], b.Mat[i]))
+                return false;
+        }
+        return true;
+    }
+
+    auto Near(const Vec3F& a, const Vec3F& b) -> bool
+    {
+        return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z);
+    }
+
+    auto Near(const Vec4F& a, const Vec4F& b) -> bool
+    {
+        return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z) && Near(a.w, b.w);
+    }
+
+    /**
+     * @brief Runs the check once for every level from scalar up to the one the CPU supports, then restores it
+     */
+    template <class Func>
+    void ForEachSimdLevel(Func&& func)
+    {
+        const auto detected = GetSimdLevel();
+        for (auto level = static_cast<uint8_t>(SIMD_LEVEL::SCALAR); level <= static_cast<uint8_t>(detected); ++level)
+        {
+            SetSimdLevel(static_cast<SIMD_LEVEL>(level));
+            func();
+        }
+        SetSimdLevel(detected);
+    }
+}
+
+LS_TEST(SimdMath_MatrixMultiplyIsRowMajorProduct)
+{
+    // A scale followed by a translation, which is not symmetric so a * transpose(b) gives a different answer
+    const auto a = MakeMatrix({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 });
+    const auto b = MakeMatrix({ 2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 1, 2, 3, 1 });
+    const auto expected = MakeMatrix({ 6, 14, 24, 4, 18, 34, 52, 8, 30, 54, 80, 12, 42, 74, 108, 16 });
+    const auto transposed = MakeMatrix({ 2, 6, 12, 18, 10, 18, 28, 46, 18, 30, 44, 74, 26, 42, 60, 102 });
+
+    LS_CHECK(MatrixMultiply(a, b).Mat == expected.Mat);
+    LS_CHECK(MatrixMultiply(a, b).Mat != transposed.Mat);
+    ForEachSimdLevel([&]()
+        {
+            LS_CHECK(Multiply(a, b).Mat == expected.Mat);
+        });
+}
+
+LS_TEST(SimdMath_RowVectorsApplyTranslation)
+{
+    const auto translate = MakeMatrix({ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1 });
+    ForEachSimdLevel([&]()
+        {
+            const auto p = Transform(Vec4F{ .x = 1, .y = 2, .z = 3, .w = 1 }, translate);
+            LS_CHECK(p.x == 6.0f && p.y == 8.0f && p.z == 10.0f && p.w == 1.0f);
+            const auto d = Transform(Vec4F{ .x = 1, .y = 2, .z = 3, .w = 0 }, translate);
+            LS_CHECK(d.x == 1.0f && d.y == 2.0f && d.z == 3.0f && d.w == 0.0f);
+        });
+}
+
+LS_TEST(SimdMath_MatrixKernelsMatchScalar)
+{
+    ForEachSimdLevel([&]()
+        {
+            LS::Test::Random rng;
+            for (auto i = 0u; i < 256u; ++i)
+            {
+                const auto a = RandomMatrix(rng);
+                const auto b = RandomMatrix(rng);
+                const Vec4F v{ .x = Signed(rng), .y = Signed(rng), .z = Signed(rng), .w = Signed(rng) };
+
+                LS_CHECK(Near(Multiply(a, b), Scalar::Multiply(a, b)));
+                LS_CHECK(Transpose(a).Mat == Scalar::Transpose(a).Mat);
+                LS_CHECK(Near(Transform(v, a), Scalar::Transform(v, a)));
+
+                const auto inverse = Inverse(a);
+                const auto reference = Scalar::Inverse(a);
+                LS_REQUIRE(inverse && reference);
+                LS_CHECK(Near(*inverse, *reference));
+                LS_CHECK(Near(Multiply(a, *inverse), Mat4F::Identity()));
+            }
+        });
+}
+
+LS_TEST(SimdMath_InverseRejectsSingular)
+{
+    const auto singular = MakeMatrix({ 1, 2, 3, 4, 2, 4, 6, 8, 0, 0, 1, 0, 0, 0, 0, 1 });
+    ForEachSimdLevel([&]()
+        {
+            LS_CHECK(!Inverse(singular).has_value());
+            LS_CHECK(Inverse(Mat4F::Identity()).has_value());
+        });
+}
+
+LS_TEST(SimdMath_BatchTransformsMatchScalar)
+{
+    // An odd count covers the 8 and 4 wide bodies and their scalar tails
+    constexpr size_t COUNT = 37u;
+    LS::Test::Random rng;
+    const auto m = RandomMatrix(rng);
+    std::vector<Vec3F> points(COUNT);
+    std::vector<Vec4F> vectors(COUNT);
+    for (auto i = 0u; i < COUNT; ++i)
+    {
+        points[i] = Vec3F{ .x = Signed(rng), .y = Signed(rng), .z = Signed(rng) };
+        vectors[i] = Vec4F{ .x = Signed(rng), .y = Signed(rng), .z = Signed(rng), .w = Signed(rng) };
+    }
+
+    std::vector<Vec3F> expectedPoints(COUNT), expectedDirections(COUNT);
+    std::vector<Vec4F> expectedVectors(COUNT);
+    Scalar::TransformPoints(m, points, expectedPoints);
+    Scalar::TransformDirections(m, points, expectedDirections);
+    Scalar::Transform(m, vectors, expectedVectors);
+
+    ForEachSimdLevel([&]()
+        {
+            std::vector<Vec3F> outPoints(COUNT), outDirections(COUNT);
+            std::vector<Vec4F> outVectors(COUNT);
+            TransformPoints(m, points, outPoints);
+            TransformDirections(m, points, outDirections);
+            Transform(m, vectors, outVectors);
+
+            // In place
+            auto inPlace = vectors;
+            Transform(m, inPlace, inPlace);
+
+            const auto stream = Vec3Stream::FromVectors(points);
+            Vec3Stream outStream;
+            TransformPoints(m, stream, outStream);
+            std::vector<Vec3F> streamPoints(COUNT);
+            outStream.ToVectors(streamPoints);
+
+            for (auto i = 0u; i < COUNT; ++i)
+            {
+                LS_CHECK(Near(outPoints[i], expectedPoints[i]));
+                LS_CHECK(Near(outDirections[i], expectedDirections[i]));
+                LS_CHECK(Near(outVectors[i], expectedVectors[i]));
+                LS_CHECK(Near(inPlace[i], expectedVectors[i]));
+                LS_CHECK(Near(streamPoints[i], expectedPoints[i]));
+            }
+        });
+}
+
+LS_TEST(SimdMath_SetSimdLevelClampsToCpu)
+{
+    const auto detected = GetSimdLevel();
+    LS_CHECK(detected <= MAX_SIMD_LEVEL);
+    LS_CHECK(SetSimdLevel(SIMD_LEVEL::AVX2) == detected);
+    LS_CHECK(SetSimdLevel(SIMD_LEVEL::SCALAR) == SIMD_LEVEL::SCALAR);
+    LS_CHECK(GetSimdLevel() == SIMD_LEVEL::SCALAR);
+    SetSimdLevel(detected);
+}
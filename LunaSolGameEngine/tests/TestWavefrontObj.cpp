@@ -0,0 +1,115 @@
+#include "LSTest.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+import LSE.Serialize.WavefrontObj;
+
+namespace
+{
+    using LS::Serialize::WavefrontObj;
+
+    auto WriteTemp(const LS::Test::TempDir& dir, std::string_view name, std::string_view text) -> std::filesystem::path
+    {
+        auto path = dir / name;
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(text.data(), text.size());
+        return path;
+    }
+
+    constexpr std::string_view QUAD = 
+        "# quad\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "vt 0\n"
+        "vt 1 1\n"
+        "f 1/1 2/2 3/2 -1/1\n";
+
+    // Repeats a triangle until the text is large enough to be split across several chunks
+    auto MakeLargeObj(size_t triangles, std::string_view badLine = {}) -> std::string
+    {
+        std::string text;
+        text.reserve(triangles * 48);
+        for (auto i = 0u; i < triangles; ++i)
+        {
+            text += "v 0.5 1.5 2.5\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\n";
+            if (i == triangles - 2 && !badLine.empty())
+                text += badLine;
+        }
+        return text;
+    }
+}
+
+LS_TEST(WavefrontObj_StreamedTriangulatesFaces)
+{
+    const LS::Test::TempDir dir("ls_test_wavefront_obj");
+    const auto path = WriteTemp(dir, "quad.obj", QUAD);
+    WavefrontObj obj;
+    LS_REQUIRE(obj.LoadStreamed(path, 1u));
+
+    LS_CHECK(obj.GetVertices().size() == 4u);
+    LS_CHECK(obj.GetTexCoords().size() == 2u);
+    LS_REQUIRE(obj.GetIndices().size() == 6u);
+    const uint32_t expected[] = { 0u, 1u, 2u, 0u, 2u, 3u };
+    for (auto i = 0u; i < 6u; ++i)
+        LS_CHECK(obj.GetIndices()[i] == expected[i]);
+    LS_CHECK(obj.GetTexCoordIndices().size() == 6u);
+    LS_CHECK(obj.GetNormalIndices().empty());
+}
+
+LS_TEST(WavefrontObj_RejectsShortRecords)
+{
+    const LS::Test::TempDir dir("ls_test_wavefront_obj");
+    for (const auto text : { std::string_view("v 1 2\nf 1 1 1\n"), std::string_view("vn 0 1\n"), std::string_view("v 1 2 x\n") })
+    {
+        const auto path = WriteTemp(dir, "short.obj", text);
+        WavefrontObj obj;
+        LS_CHECK(!obj.LoadStreamed(path, 1u));
+    }
+}
+
+LS_TEST(WavefrontObj_FailedLoadKeepsPreviousObject)
+{
+    const LS::Test::TempDir dir("ls_test_wavefront_obj");
+    const auto good = WriteTemp(dir, "good.obj", QUAD);
+    const auto bad = WriteTemp(dir, "bad.obj", MakeLargeObj(100'000, "v 1 2\n"));
+
+    WavefrontObj obj;
+    LS_REQUIRE(obj.LoadStreamed(good, 1u));
+    // Large enough to be parsed in several chunks, the bad record lands in the last one
+    LS_CHECK(!obj.LoadStreamed(bad, 4u));
+    LS_CHECK(obj.GetVertices().size() == 4u);
+    LS_CHECK(obj.GetIndices().size() == 6u);
+}
+
+LS_TEST(WavefrontObj_ChunkedMatchesSingleThreaded)
+{
+    const LS::Test::TempDir dir("ls_test_wavefront_obj");
+    const auto path = WriteTemp(dir, "large.obj", MakeLargeObj(100'000));
+    WavefrontObj single;
+    WavefrontObj chunked;
+    LS_REQUIRE(single.LoadStreamed(path, 1u));
+    LS_REQUIRE(chunked.LoadStreamed(path, 4u));
+
+    LS_CHECK(single.GetVertices().size() == 300'000u);
+    LS_REQUIRE(single.GetIndices().size() == chunked.GetIndices().size());
+    LS_CHECK(std::equal(single.GetIndices().begin(), single.GetIndices().end(), chunked.GetIndices().begin()));
+    LS_CHECK(chunked.GetIndices().back() == 299'999u);
+}
+
+LS_TEST(WavefrontObj_LoadObjectDropsStreamedIndices)
+{
+    const LS::Test::TempDir dir("ls_test_wavefront_obj");
+    const auto path = WriteTemp(dir, "reload.obj", QUAD);
+    WavefrontObj obj;
+    LS_REQUIRE(obj.LoadStreamed(path, 1u));
+    LS_REQUIRE(obj.LoadFile(path));
+    LS_REQUIRE(obj.LoadObject());
+
+    LS_CHECK(obj.GetIndices().empty());
+    LS_CHECK(obj.GetTexCoordIndices().empty());
+    LS_CHECK(obj.GetVertices().size() == 4u);
+    LS_CHECK(obj.GetFaces().size() == 1u);
+}